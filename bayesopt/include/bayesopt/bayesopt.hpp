@@ -107,8 +107,9 @@ namespace bayesopt  {
      * \brief Call the inner optimization method to find the optimal
      * point acording to the criteria.  
      * @param xOpt optimal point
+     * @return value of the criteria at the optimal point
      */
-    void findOptimal(vectord &xOpt);
+    double findOptimal(vectord &xOpt);
 
     /** Remap the point x to the original space (e.g.:
 	unnormalization) */
@@ -192,8 +193,9 @@ namespace bayesopt  {
      * \brief Call the inner optimization method to find the optimal
      * point acording to the criteria.  
      * @param xOpt optimal point
+     * @return value of the criteria at the optimal point
      */
-    void findOptimal(vectord &xOpt);
+    double findOptimal(vectord &xOpt);
 
     /** Remap the point x to the original space  */
     vectord remapPoint(const vectord& x);
@@ -153,6 +153,11 @@ namespace bayesopt {
         // Getters and Setters
         ProbabilityDistribution *getPrediction(const vectord &query);
 
+        /** Predictions of the surrogate for a block of query points in the
+         * inner space (one per row). */
+        ProbabilityDistribution *getPredictionBatch(const matrixd &queries,
+                                                    vectord &mean, vectord &std);
+
         const Dataset *getData();
 
         Parameters *getParameters();
@@ -161,8 +166,17 @@ namespace bayesopt {
 
         size_t getCurrentIter();
 
+        /** Value of the criteria at the last point chosen by the inner
+         * optimization, before that point was evaluated. For cEI it is
+         * the negative of the largest expected improvement. */
+        double getLastCriteriaValue();
+
         double evaluateCriteria(const vectord &query);
 
+        /** Evaluates the criteria for a block of query points in the inner
+         * space (one per row). Unreachable points are evaluated as 0. */
+        void evaluateCriteriaBatch(const matrixd &queries, vectord &values);
+
     protected:
         /** Get optimal point in the inner space (e.g.: [0-1] hypercube) */
         vectord getPointAtMinimum();
@@ -180,8 +194,9 @@ namespace bayesopt {
          * \brief Call the inner optimization method to find the optimal
          * point acording to the criteria.
          * @param xOpt optimal point
+         * @return value of the criteria at the optimal point
          */
-        virtual void findOptimal(vectord &xOpt) = 0;
+        virtual double findOptimal(vectord &xOpt) = 0;
 
         /** Remap the point x to the original space (e.g.:
         unnormalization) */
@@ -215,6 +230,7 @@ namespace bayesopt {
     private:
         double mYPrev;
         size_t mCounterStuck;
+        double mLastCriteria;         ///< Criteria at the last chosen point
     private:
 
         BayesOptBase();
@@ -83,6 +83,8 @@ extern "C" {
   typedef struct {
     size_t n_iterations;         /**< Maximum BayesOpt evaluations (budget) */
     size_t n_inner_iterations;   /**< Maximum inner optimizer evaluations */
+    size_t n_inner_starts;       /**< If >0, number of parallel local searches
+				      of the criteria instead of the global one */
     size_t n_init_samples;       /**< Number of samples before optimization */
     size_t n_iter_relearn;       /**< Number of samples before relearn kernel */
 
@@ -101,6 +103,7 @@ extern "C" {
     char* save_filename;          /**< Sava data file path (if applicable) */
 
     char* surr_name;             /**< Name of the surrogate function */
+    size_t n_window_samples;     /**< Samples used by sGaussianProcessWindow */
     double sigma_s;              /**< Signal variance (if known). 
 				    Used in GaussianProcess and GaussianProcessNormal */
     double noise;                /**< Variance of observation noise (and nugget) */
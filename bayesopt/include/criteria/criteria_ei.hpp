@@ -55,6 +55,19 @@ namespace bayesopt
       return mProc->prediction(x)->negativeExpectedImprovement(min,mExp); 
     };
 
+    void evaluateBatch(const matrixd &queries, vectord& values)
+    {
+      const double min = mProc->getValueAtMinimum();
+      vectord mean, std;
+      ProbabilityDistribution* d = mProc->predictionBatch(queries,mean,std);
+      values.resize(queries.size1(),false);
+      for(size_t q = 0; q < values.size(); ++q)
+	{
+	  d->setMeanAndStd(mean(q),std(q));
+	  values(q) = d->negativeExpectedImprovement(min,mExp);
+	}
+    };
+
     std::string name() {return "cEI";};
 
   private:
@@ -51,6 +51,18 @@ namespace bayesopt
     { 
       return mProc->prediction(x)->lowerConfidenceBound(mBeta); 
     };
+
+    void evaluateBatch(const matrixd &queries, vectord& values)
+    {
+      vectord mean, std;
+      ProbabilityDistribution* d = mProc->predictionBatch(queries,mean,std);
+      values.resize(queries.size1(),false);
+      for(size_t q = 0; q < values.size(); ++q)
+	{
+	  d->setMeanAndStd(mean(q),std(q));
+	  values(q) = d->lowerConfidenceBound(mBeta);
+	}
+    };
     std::string name() {return "cLCB";};
   private:
     double mBeta;
@@ -26,6 +26,7 @@
 #define  _CRITERIA_FUNCTORS_HPP_
 
 #include <map>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
 #include "nonparametricprocess.hpp"
 
 namespace bayesopt
@@ -49,6 +50,9 @@ namespace bayesopt
     double evaluate(const vectord &x)  {return (*this)(x);}
     virtual double operator() (const vectord &x)  = 0;
 
+    /** Evaluates the criterion for every query point (one per row) */
+    virtual void evaluateBatch(const matrixd &queries, vectord& values);
+
     virtual std::string name() = 0;
     virtual void setParameters(const vectord &params) = 0;
     virtual size_t nParameters() = 0;
@@ -73,6 +77,16 @@ namespace bayesopt
     randEngine* mtRandom;
   };
 
+  inline void Criteria::evaluateBatch(const matrixd &queries, vectord& values)
+  {
+    values.resize(queries.size1(),false);
+    for(size_t q = 0; q < queries.size1(); ++q)
+      {
+	const vectord query = boost::numeric::ublas::row(queries,q);
+	values(q) = (*this)(query);
+      }
+  };
+
 
   /** 
    * \brief Factory model for criterion functions
@@ -54,6 +54,19 @@ namespace bayesopt
      */	
     ProbabilityDistribution* prediction(const vectord &query);
 
+    /** 
+     * \brief Predictions for a block of query points in the hypercube
+     * [0,1]. The kernel, the solve and the reductions run over all the
+     * queries at once.
+     * 
+     * @param queries query points, one per row
+     * @param mean output: predicted mean of each query
+     * @param std output: predicted standard deviation of each query
+     * @return pointer to the probability distribution of the last query.
+     */	
+    ProbabilityDistribution* predictionBatch(const matrixd &queries,
+					     vectord& mean, vectord& std);
+
   private:
 
     /** 
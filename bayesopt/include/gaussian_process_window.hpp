@@ -0,0 +1,103 @@
+/** \file gaussian_process_window.hpp
+    \brief Gaussian process conditioned on a window of the data */
+/*
+-------------------------------------------------------------------------
+   This file is part of BayesOpt, an efficient C++ library for
+   Bayesian optimization.
+
+   Copyright (C) 2011-2015 Ruben Martinez-Cantin <rmcantin@unizar.es>
+
+   BayesOpt is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Affero General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   BayesOpt is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with BayesOpt.  If not, see <http://www.gnu.org/licenses/>.
+------------------------------------------------------------------------
+*/
+
+#ifndef  _GAUSSIAN_PROCESS_WINDOW_HPP_
+#define  _GAUSSIAN_PROCESS_WINDOW_HPP_
+
+#include "gaussian_process.hpp"
+
+
+namespace bayesopt
+{
+
+  /** \addtogroup NonParametricProcesses */
+  /**@{*/
+
+  /**
+   * \brief Samples of the window and their mean features. They are
+   * constructed before the process, which is conditioned on them.
+   */
+  class WindowData
+  {
+  protected:
+    WindowData(size_t dim, Parameters params);
+
+    Dataset mWindow;             ///< Samples the process is conditioned on
+    MeanModel mWindowMean;       ///< Mean model evaluated at the window
+  };
+
+
+  /**
+   * \brief Gaussian process conditioned only on a window of the data,
+   * made of the best and the most recent samples. The cost of
+   * learning and updating the process is bounded by the size of the
+   * window instead of growing with the number of samples.
+   *
+   * While the data fits in the window, it is equivalent to the
+   * standard GaussianProcess.
+   */
+  class GaussianProcessWindow: private WindowData, public GaussianProcess
+  {
+  public:
+    GaussianProcessWindow(size_t dim, Parameters params, const Dataset& data,
+			  MeanModel& mean, randEngine& eng);
+    virtual ~GaussianProcessWindow();
+
+    /**
+     * \brief Selects the window from the data and computes the
+     * surrogate model from scratch.
+     */
+    void fitSurrogateModel();
+
+    /**
+     * \brief Adds the last sample to the window. If the window is
+     * full, it is selected again and the surrogate model is recomputed,
+     * which costs a fixed amount given by the size of the window.
+     */
+    void updateSurrogateModel();
+
+    /**
+     * \brief Score of the kernel parameters, computed on the window of
+     * the current data.
+     */
+    double evaluate(const vectord &x);
+
+  private:
+    /**
+     * \brief Selects the samples of the window if the data has changed
+     * since the last selection.
+     */
+    void updateWindow();
+
+    const Dataset& mFullData;    ///< All the samples
+    size_t mWindowSize;          ///< Maximum number of samples of the window
+    size_t mSelectedSamples;     ///< Number of samples at the last selection
+  };
+
+  /**@}*/
+
+} //namespace bayesopt
+
+
+#endif
@@ -68,6 +68,16 @@ namespace bayesopt {
      */
     double run(vectord &Xnext);
 
+    /** 
+     * Launch local optimizations from every starting point in
+     * parallel. Each of them uses the maximum number of evaluations.
+     * 
+     * @param starts initial points, one per row
+     * @param Xnext output: best result
+     * @return minimum value
+     */
+    double runMultiStart(const matrixd& starts, vectord& Xnext);
+
     /** 
      * Try some local optimization around a point
      * 
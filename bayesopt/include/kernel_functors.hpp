@@ -27,6 +27,7 @@
 #include <map>
 #include <boost/scoped_ptr.hpp>
 #include <boost/math/distributions/normal.hpp> 
+#include <boost/numeric/ublas/matrix_proxy.hpp>
 #include "bayesopt/parameters.hpp"
 #include "specialtypes.hpp"
 
@@ -55,10 +56,33 @@ namespace bayesopt
     virtual double gradient( const vectord &x1, const vectord &x2,
 			     size_t component ) = 0;
 
+    /** 
+     * \brief Evaluates the kernel between every point and every query.
+     * @param XX points, one per row of the block
+     * @param queries query points, one per row
+     * @param block output: kernel values, one column per query
+     */
+    virtual void computeBlock(const vecOfvec& XX, const matrixd& queries,
+			      matrixd& block);
+
   protected:
     size_t n_inputs;
   };
 
+  inline void Kernel::computeBlock(const vecOfvec& XX, 
+				   const matrixd& queries, matrixd& block)
+  {
+    block.resize(XX.size(),queries.size1(),false);
+    for(size_t q = 0; q < queries.size1(); ++q)
+      {
+	const vectord query = boost::numeric::ublas::row(queries,q);
+	for(size_t i = 0; i < XX.size(); ++i)
+	  {
+	    block(i,q) = (*this)(XX[i],query);
+	  }
+      }
+  }
+
 
 
   template <typename KernelType> Kernel * create_func()
@@ -118,7 +142,10 @@ namespace bayesopt
     vectord computeCrossCorrelation(const vecOfvec& XX, const vectord &query);
     void computeCrossCorrelation(const vecOfvec& XX, const vectord &query,
 				 vectord& knx);
+    void computeCrossCorrelation(const vecOfvec& XX, const matrixd &queries,
+				 matrixd& knx);
     double computeSelfCorrelation(const vectord& query);
+    void computeSelfCorrelation(const matrixd& queries, vectord& kqq);
     double kernelLogPrior();
 
   private:
@@ -160,9 +187,25 @@ namespace bayesopt
   }
 
 
+  inline void KernelModel::computeCrossCorrelation(const vecOfvec& XX, 
+						   const matrixd &queries,
+						   matrixd& knx)
+  { mKernel->computeBlock(XX,queries,knx); }
+
   inline double KernelModel::computeSelfCorrelation(const vectord& query)
   { return (*mKernel)(query,query); }
 
+  inline void KernelModel::computeSelfCorrelation(const matrixd& queries,
+						  vectord& kqq)
+  {
+    kqq.resize(queries.size1(),false);
+    for(size_t q = 0; q < queries.size1(); ++q)
+      {
+	const vectord query = boost::numeric::ublas::row(queries,q);
+	kqq(q) = (*mKernel)(query,query);
+      }
+  }
+
   inline void KernelModel::setKernelPrior (const vectord &theta, 
 					   const vectord &s_theta)
   {
@@ -96,9 +96,17 @@ namespace bayesopt
     vectord computeCrossCorrelation(const vectord &query);
     double computeSelfCorrelation(const vectord& query);
 
+    /** Cross correlation of the samples (rows) and the queries (columns) */
+    void computeCrossCorrelation(const matrixd &queries, matrixd& knx);
+    void computeSelfCorrelation(const matrixd& queries, vectord& kqq);
+
     /** Computes the Cholesky decomposition of the Correlation matrix */
     void computeCholeskyCorrelation();
 
+    /** Solves L*V = B in place for every column of the block, in the
+     *	same order as ublas::inplace_solve does for a single one. */
+    void solveCholeskyBlock(matrixd& block);
+
 
   protected:
     matrixd mL;             ///< Cholesky decomposition of the Correlation matrix
@@ -203,6 +211,14 @@ namespace bayesopt
   inline double KernelRegressor::computeSelfCorrelation(const vectord& query)
   { return mKernel.computeSelfCorrelation(query); }
 
+  inline void KernelRegressor::computeCrossCorrelation(const matrixd &queries,
+						       matrixd& knx)
+  { mKernel.computeCrossCorrelation(mData.mX,queries,knx); }
+
+  inline void KernelRegressor::computeSelfCorrelation(const matrixd& queries,
+						      vectord& kqq)
+  { mKernel.computeSelfCorrelation(queries,kqq); }
+
   inline void KernelRegressor::addNewPointToCholesky(const vectord& correlation,
 							  double selfcorrelation)
   {
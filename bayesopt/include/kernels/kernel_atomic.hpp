@@ -24,6 +24,8 @@
 #ifndef  _KERNEL_ATOMIC_HPP_
 #define  _KERNEL_ATOMIC_HPP_
 
+#include <algorithm>
+#include <cmath>
 #include <valarray>
 #include "kernel_functors.hpp"
 #include "ublas_elementwise.hpp"
@@ -63,6 +65,22 @@ namespace bayesopt
     virtual ~AtomicKernel(){};
 
   protected:
+    /** Applies the radial function to every element of the block. */
+    template <typename Function>
+    static void transformBlock(matrixd& block, Function radial)
+    {
+      matrixd::array_type& data = block.data();
+      for(size_t i = 0; i < data.size(); ++i)
+	{
+	  data[i] = radial(data[i]);
+	}
+    };
+
+    /** Transposes the queries, so that each coordinate of all the
+     *	queries is contiguous. */
+    static matrixd transposeQueries(const matrixd& queries)
+    { return boost::numeric::ublas::trans(queries); };
+
     size_t n_params;
     vectord params;
   };
@@ -82,6 +100,36 @@ namespace bayesopt
       assert(x1.size() == x2.size());
       return norm_2(x1-x2)/params(0); 
     };
+
+    /** Weighted norms between every point and every query, computed
+     *	in the same order as computeWeightedNorm2. */
+    void computeNormBlock(const vecOfvec& XX, const matrixd& queries,
+			  matrixd& block)
+    {
+      const matrixd qt = transposeQueries(queries);
+      const size_t m = queries.size1();
+      block.resize(XX.size(),m,false);
+      if (m == 0) return;
+      for (size_t i = 0; i < XX.size(); ++i)
+	{
+	  double* b = &block(i,0);
+	  std::fill(b,b+m,0.0);
+	  for (size_t k = 0; k < n_inputs; ++k)
+	    {
+	      const double x = XX[i](k);
+	      const double* q = &qt(k,0);
+	      for (size_t j = 0; j < m; ++j)
+		{
+		  const double d = x - q[j];
+		  b[j] += d*d;
+		}
+	    }
+	  for (size_t j = 0; j < m; ++j)
+	    {
+	      b[j] = std::sqrt(b[j])/params(0);
+	    }
+	}
+    };
   };
 
   /** \brief Abstract class for anisotropic kernel functors using ARD
@@ -103,6 +151,37 @@ namespace bayesopt
       vectord r = utils::ublas_elementwise_div(xd, params);
       return norm_2(r);
     };
+
+    /** Weighted norms between every point and every query, computed
+     *	in the same order as computeWeightedNorm2. */
+    void computeNormBlock(const vecOfvec& XX, const matrixd& queries,
+			  matrixd& block)
+    {
+      const matrixd qt = transposeQueries(queries);
+      const size_t m = queries.size1();
+      block.resize(XX.size(),m,false);
+      if (m == 0) return;
+      for (size_t i = 0; i < XX.size(); ++i)
+	{
+	  double* b = &block(i,0);
+	  std::fill(b,b+m,0.0);
+	  for (size_t k = 0; k < n_inputs; ++k)
+	    {
+	      const double x = XX[i](k);
+	      const double p = params(k);
+	      const double* q = &qt(k,0);
+	      for (size_t j = 0; j < m; ++j)
+		{
+		  const double d = (x - q[j])/p;
+		  b[j] += d*d;
+		}
+	    }
+	  for (size_t j = 0; j < m; ++j)
+	    {
+	      b[j] = std::sqrt(b[j]);
+	    }
+	}
+    };
   };
 
   //@}
@@ -39,12 +39,21 @@ namespace bayesopt
     { n_params = 1; n_inputs = input_dim;  };
 
     double operator()( const vectord &x1, const vectord &x2)
+    { return radial(computeWeightedNorm2(x1,x2)); };
+
+    static double radial(double rl)
     {
-      double rl = computeWeightedNorm2(x1,x2);
       double k = rl*rl;
       return exp(-k/2);
     };
 
+    void computeBlock(const vecOfvec& XX, const matrixd& queries,
+		      matrixd& block)
+    {
+      computeNormBlock(XX,queries,block);
+      transformBlock(block,radial);
+    };
+
     double gradient(const vectord &x1, const vectord &x2,
 		    size_t component)
     {
@@ -63,11 +72,20 @@ namespace bayesopt
     { n_params = input_dim;  n_inputs = input_dim; };
 
     double operator()( const vectord &x1, const vectord &x2 )
+    { return radial(computeWeightedNorm2(x1,x2)); };
+
+    static double radial(double rl)
     {
-      double rl = computeWeightedNorm2(x1,x2);
       double k = rl*rl;
       return exp(-k/2);
     };
+
+    void computeBlock(const vecOfvec& XX, const matrixd& queries,
+		      matrixd& block)
+    {
+      computeNormBlock(XX,queries,block);
+      transformBlock(block,radial);
+    };
   
     double gradient(const vectord &x1, const vectord &x2,
 		    size_t component)
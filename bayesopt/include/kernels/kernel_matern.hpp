@@ -40,9 +40,16 @@ namespace bayesopt
     { n_params = 1;  n_inputs = input_dim;  };
 
     double operator()(const vectord &x1, const vectord &x2)
+    { return radial(computeWeightedNorm2(x1,x2)); };
+
+    static double radial(double r)
+    { return exp(-r); };
+
+    void computeBlock(const vecOfvec& XX, const matrixd& queries,
+		      matrixd& block)
     {
-      double r = computeWeightedNorm2(x1,x2);
-      return exp(-r);
+      computeNormBlock(XX,queries,block);
+      transformBlock(block,radial);
     };
 
     double gradient(const vectord &x1, const vectord &x2,
@@ -62,9 +69,16 @@ namespace bayesopt
     { n_params = input_dim; n_inputs = input_dim;  };
 
     double operator()(const vectord &x1, const vectord &x2)
+    { return radial(computeWeightedNorm2(x1,x2)); };
+
+    static double radial(double r)
+    { return exp(-r); };
+
+    void computeBlock(const vecOfvec& XX, const matrixd& queries,
+		      matrixd& block)
     {
-      double r = computeWeightedNorm2(x1,x2);
-      return exp(-r);
+      computeNormBlock(XX,queries,block);
+      transformBlock(block,radial);
     };
 
     //TODO: 
@@ -82,12 +96,22 @@ namespace bayesopt
     { n_params = 1; n_inputs = input_dim;  };
 
     double operator()( const vectord &x1, const vectord &x2)
+    { return radial(computeWeightedNorm2(x1,x2)); };
+
+    static double radial(double norm)
     {
-      double r = sqrt(3.0) * computeWeightedNorm2(x1,x2);
+      double r = sqrt(3.0) * norm;
       double er = exp(-r);
       return (1+r)*er;
     };
 
+    void computeBlock(const vecOfvec& XX, const matrixd& queries,
+		      matrixd& block)
+    {
+      computeNormBlock(XX,queries,block);
+      transformBlock(block,radial);
+    };
+
     double gradient( const vectord &x1, const vectord &x2,
 		     size_t component)
     {
@@ -105,12 +129,22 @@ namespace bayesopt
     { n_params = input_dim;  n_inputs = input_dim; };
 
     double operator()( const vectord &x1, const vectord &x2)
+    { return radial(computeWeightedNorm2(x1,x2)); };
+
+    static double radial(double norm)
     {
-      double r = sqrt(3.0) * computeWeightedNorm2(x1,x2);
+      double r = sqrt(3.0) * norm;
       double er = exp(-r);
       return (1+r)*er;
     };
 
+    void computeBlock(const vecOfvec& XX, const matrixd& queries,
+		      matrixd& block)
+    {
+      computeNormBlock(XX,queries,block);
+      transformBlock(block,radial);
+    };
+
     double gradient( const vectord &x1, const vectord &x2,
 		     size_t component)
     {
@@ -127,11 +161,21 @@ namespace bayesopt
     { n_params = 1; n_inputs = input_dim;  };
 
     double operator()( const vectord &x1, const vectord &x2)
+    { return radial(computeWeightedNorm2(x1,x2)); };
+
+    static double radial(double norm)
     {
-      double r = sqrt(5.0) * computeWeightedNorm2(x1,x2);
+      double r = sqrt(5.0) * norm;
       double er = exp(-r);
       return (1+r*(1+r/3))*er;
     };
+
+    void computeBlock(const vecOfvec& XX, const matrixd& queries,
+		      matrixd& block)
+    {
+      computeNormBlock(XX,queries,block);
+      transformBlock(block,radial);
+    };
     double gradient( const vectord &x1, const vectord &x2,
 		     size_t component)
     {    
@@ -150,12 +194,22 @@ namespace bayesopt
     { n_params = input_dim;  n_inputs = input_dim; };
 
     double operator()( const vectord &x1, const vectord &x2)
+    { return radial(computeWeightedNorm2(x1,x2)); };
+
+    static double radial(double norm)
     {
-      double r = sqrt(5.0) * computeWeightedNorm2(x1,x2);
+      double r = sqrt(5.0) * norm;
       double er = exp(-r);
       return (1+r*(1+r/3))*er;
     };
 
+    void computeBlock(const vecOfvec& XX, const matrixd& queries,
+		      matrixd& block)
+    {
+      computeNormBlock(XX,queries,block);
+      transformBlock(block,radial);
+    };
+
     //TODO:
     double gradient( const vectord &x1, const vectord &x2,
 		     size_t component)
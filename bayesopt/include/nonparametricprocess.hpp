@@ -26,6 +26,11 @@
 #ifndef __BAYESIANREGRESSOR_HPP__
 #define __BAYESIANREGRESSOR_HPP__
 
+#include <boost/scoped_ptr.hpp>
+#include <boost/optional.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "dataset.hpp"
 #include "prob_distribution.hpp"
 #include "mean_functors.hpp"
@@ -64,9 +69,25 @@ namespace bayesopt
      * in the hypercube [0,1].
      * 
      * @param query in the hypercube [0,1] to evaluate the Gaussian process
-     * @return pointer to the probability distribution.
+     * @return pointer to the probability distribution. It is valid until
+     * the next prediction of the same thread.
      */	
     virtual ProbabilityDistribution* prediction(const vectord &query) = 0;
+
+    /** 
+     * \brief Predictions for a block of query points in the hypercube
+     * [0,1].
+     * 
+     * @param queries query points, one per row
+     * @param mean output: predicted mean of each query
+     * @param std output: predicted standard deviation of each query
+     * @return pointer to the probability distribution of the last
+     * query, NULL if there are none. Other queries can be evaluated
+     * by setting their mean and std.
+     */	
+    virtual ProbabilityDistribution* predictionBatch(const matrixd &queries,
+						     vectord& mean,
+						     vectord& std);
 		 		 
     /** 
      * \brief Computes the initial surrogate model and updates the
@@ -98,6 +119,15 @@ namespace bayesopt
 
 
   protected:
+    /** 
+     * \brief Distribution in which the prediction is stored. Inside of
+     * parallel regions each thread uses its own copy of the shared one,
+     * so that predictions can be computed concurrently. The copy is
+     * stored once per thread and refreshed without allocating.
+     */
+    template <class Distribution>
+    static Distribution* threadDistribution(Distribution* shared);
+
     const Dataset& mData;  
     double mSigma;                                   //!< Signal variance
     size_t dim_;
@@ -117,6 +147,22 @@ namespace bayesopt
   inline double NonParametricProcess::getSignalVariance() 
   { return mSigma; };
 
+  template <class Distribution>
+  inline Distribution* NonParametricProcess::threadDistribution(Distribution* shared)
+  {
+#ifdef _OPENMP
+    if (omp_in_parallel())
+      {
+	// The copy is rebuilt in place, as the distributions hold a
+	// reference to the random engine and cannot be assigned.
+	static thread_local boost::optional<Distribution> local;
+	local.emplace(*shared);
+	return local.get_ptr();
+      }
+#endif
+    return shared;
+  };
+
   /**@}*/
   
 } //namespace bayesopt
@@ -61,6 +61,7 @@ namespace bayesopt {
     void updateSurrogateModel();
 
     double evaluateCriteria(const vectord& query);
+    void evaluateCriteriaBatch(const matrixd& queries, vectord& values);
     void updateCriteria(const vectord& query);
 
     bool criteriaRequiresComparison();
@@ -69,6 +70,8 @@ namespace bayesopt {
     std::string getBestCriteria(vectord& best);
 
     ProbabilityDistribution* getPrediction(const vectord& query);
+    ProbabilityDistribution* getPredictionBatch(const matrixd& queries,
+						vectord& mean, vectord& std);
 
   private:
     EmpiricalBayes();
@@ -94,6 +97,10 @@ namespace bayesopt {
   inline double EmpiricalBayes::evaluateCriteria(const vectord& query)
   { return (*mCrit)(query); };
 
+  inline void EmpiricalBayes::evaluateCriteriaBatch(const matrixd& queries, 
+					       vectord& values)
+  { mCrit->evaluateBatch(queries,values); };
+
   inline void EmpiricalBayes::updateCriteria(const vectord& query)
   { return mCrit->update(query); };
 
@@ -115,6 +122,10 @@ namespace bayesopt {
   inline  ProbabilityDistribution* EmpiricalBayes::getPrediction(const vectord& query)
   { return mGP->prediction(query); };
 
+  inline  ProbabilityDistribution* 
+  EmpiricalBayes::getPredictionBatch(const matrixd& queries, vectord& mean, vectord& std)
+  { return mGP->predictionBatch(queries,mean,std); };
+
 
 } //namespace bayesopt
 
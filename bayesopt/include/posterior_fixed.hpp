@@ -61,6 +61,7 @@ namespace bayesopt {
     void updateSurrogateModel();
 
     double evaluateCriteria(const vectord& query);
+    void evaluateCriteriaBatch(const matrixd& queries, vectord& values);
     void updateCriteria(const vectord& query);
 
     bool criteriaRequiresComparison();
@@ -69,6 +70,8 @@ namespace bayesopt {
     std::string getBestCriteria(vectord& best);
 
     ProbabilityDistribution* getPrediction(const vectord& query);
+    ProbabilityDistribution* getPredictionBatch(const matrixd& queries,
+						vectord& mean, vectord& std);
 
   private:
     PosteriorFixed();
@@ -95,6 +98,10 @@ namespace bayesopt {
   inline double PosteriorFixed::evaluateCriteria(const vectord& query)
   { return (*mCrit)(query); };
 
+  inline void PosteriorFixed::evaluateCriteriaBatch(const matrixd& queries, 
+					       vectord& values)
+  { mCrit->evaluateBatch(queries,values); };
+
   inline void PosteriorFixed::updateCriteria(const vectord& query)
   { return mCrit->update(query); };
 
@@ -116,6 +123,10 @@ namespace bayesopt {
   inline  ProbabilityDistribution* PosteriorFixed::getPrediction(const vectord& query)
   { return mGP->prediction(query); };
 
+  inline  ProbabilityDistribution* 
+  PosteriorFixed::getPredictionBatch(const matrixd& queries, vectord& mean, vectord& std)
+  { return mGP->predictionBatch(queries,mean,std); };
+
 
 } //namespace bayesopt
 
@@ -43,6 +43,11 @@ namespace bayesopt {
    * to avoid costly operations like matrix inversions for every
    * kernel parameter in a GP prediction. Thus, we assume that the
    * number of particles is not very large.
+   *
+   * After the first relearning, each particle is moved by its own
+   * short Markov chain, which uses the process of that particle as
+   * the walker. The chains do not share any kernel matrices, thus
+   * they are run in parallel when OpenMP is available.
    */
   class MCMCModel: public PosteriorModel
   {
@@ -67,6 +72,7 @@ namespace bayesopt {
     void updateSurrogateModel();
 
     double evaluateCriteria(const vectord& query);
+    void evaluateCriteriaBatch(const matrixd& queries, vectord& values);
     void updateCriteria(const vectord& query);
 
     bool criteriaRequiresComparison();
@@ -75,10 +81,20 @@ namespace bayesopt {
     std::string getBestCriteria(vectord& best);
 
     ProbabilityDistribution* getPrediction(const vectord& query);
+    ProbabilityDistribution* getPredictionBatch(const matrixd& queries,
+						vectord& mean, vectord& std);
    
   private:
     void setSurrogateModel(randEngine& eng);    
     void setCriteria(randEngine& eng);
+    void setChainSamplers(size_t nSteps);
+
+    /** Applies the function to the index of every particle in
+     *	parallel. Exceptions are rethrown after all of them finish.
+     *	When the chains write the mean model, which the particles
+     *	share, they are processed serially. */
+    template <typename Function>
+    void forEachParticle(Function function);
 
   private:  // Members
     size_t nParticles;
@@ -86,6 +102,10 @@ namespace bayesopt {
     CritVect mCrit;                    ///< Metacriteria model
 
     boost::scoped_ptr<MCMCSampler> kSampler;
+    std::vector<randEngine> mChainEngines;    ///< Engines of the chains of particles
+    boost::ptr_vector<MCMCSampler> mChainSamplers; ///< Chains started at each particle
+    bool mIsSampled;                ///< Whether the particles follow the posterior
+    randEngine& mtRandom;
 
   private: //Forbidden
     MCMCModel();
@@ -94,18 +114,6 @@ namespace bayesopt {
 
   /**@}*/
 
-  inline void MCMCModel::fitSurrogateModel()
-  { 
-    for(GPVect::iterator it=mGP.begin(); it != mGP.end(); ++it)
-      it->fitSurrogateModel(); 
-  };
-
-  inline void MCMCModel::updateSurrogateModel()
-  {     
-    for(GPVect::iterator it=mGP.begin(); it != mGP.end(); ++it)
-      it->updateSurrogateModel(); 
-  };
-
   inline double MCMCModel::evaluateCriteria(const vectord& query)
   { 
     double sum = 0.0;
@@ -116,6 +124,19 @@ namespace bayesopt {
     return sum/static_cast<double>(nParticles);
   };
 
+  inline void MCMCModel::evaluateCriteriaBatch(const matrixd& queries,
+					       vectord& values)
+  { 
+    values = zvectord(queries.size1());
+    vectord particleValues;
+    for(CritVect::iterator it=mCrit.begin(); it != mCrit.end(); ++it)
+      {
+	it->evaluateBatch(queries,particleValues);
+	values += particleValues;
+      }
+    values /= static_cast<double>(nParticles);
+  };
+
   inline void MCMCModel::updateCriteria(const vectord& query)
   { 
     for(CritVect::iterator it=mCrit.begin(); it != mCrit.end(); ++it)
@@ -158,6 +179,11 @@ namespace bayesopt {
   ProbabilityDistribution* MCMCModel::getPrediction(const vectord& query)
   { return mGP[0].prediction(query); };
 
+  inline ProbabilityDistribution* 
+  MCMCModel::getPredictionBatch(const matrixd& queries, vectord& mean,
+				vectord& std)
+  { return mGP[0].predictionBatch(queries,mean,std); };
+
 
 
 } //namespace bayesopt
@@ -63,6 +63,9 @@ namespace bayesopt {
     virtual void updateSurrogateModel() = 0;
 
     virtual double evaluateCriteria(const vectord& query) = 0;
+    /** Evaluates the criteria for every query point (one per row) */
+    virtual void evaluateCriteriaBatch(const matrixd& queries, 
+				       vectord& values) = 0;
     virtual void updateCriteria(const vectord& query) = 0;
 
     virtual bool criteriaRequiresComparison() = 0;
@@ -83,6 +86,9 @@ namespace bayesopt {
 
     const Dataset* getData();
     virtual ProbabilityDistribution* getPrediction(const vectord& query) = 0;
+    virtual ProbabilityDistribution* getPredictionBatch(const matrixd& queries,
+							vectord& mean,
+							vectord& std) = 0;
 
 
   protected:
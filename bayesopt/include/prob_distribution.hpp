@@ -84,6 +84,11 @@ namespace bayesopt
     virtual double getMean() = 0;
     virtual double getStd() = 0;
 
+    /** 
+     * \brief Sets the mean and std of the distribution
+     */
+    virtual void setMeanAndStd(double mean, double std) = 0;
+
   protected:
     randEngine& mtRandom;
   };
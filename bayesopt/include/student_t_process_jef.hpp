@@ -72,7 +72,6 @@ namespace bayesopt
 
   private:
     vectord mWML;           //!< GP ML parameters
-    vectord mKn;
     /// Precomputed GP prediction operations
     vectord mAlphaF;
     matrixd mKF, mL2;
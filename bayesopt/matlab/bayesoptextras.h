@@ -232,6 +232,7 @@ bopt_params load_parameters(const mxArray* params)
 
   struct_size(params,"n_iterations", &parameters.n_iterations);
   struct_size(params,"n_inner_iterations", &parameters.n_inner_iterations);
+  struct_size(params,"n_inner_starts", &parameters.n_inner_starts);
   struct_size(params, "n_init_samples", &parameters.n_init_samples);
   struct_size(params, "n_iter_relearn", &parameters.n_iter_relearn);
 
@@ -247,6 +248,7 @@ bopt_params load_parameters(const mxArray* params)
 
   
   struct_string(params, "surr_name", parameters.surr_name);
+  struct_size(params, "n_window_samples", &parameters.n_window_samples);
 
   struct_value(params, "sigma_s", &parameters.sigma_s);
   struct_value(params, "noise", &parameters.noise);
@@ -58,6 +58,7 @@ cdef extern from "bayesopt/parameters.h":
     ctypedef struct bopt_params:
         unsigned int n_iterations
         unsigned int n_inner_iterations
+        unsigned int n_inner_starts
         unsigned int n_init_samples
         unsigned int n_iter_relearn
         unsigned int init_method
@@ -68,6 +69,7 @@ cdef extern from "bayesopt/parameters.h":
         char* load_filename
         char* save_filename
         char* surr_name
+        unsigned int n_window_samples
         double sigma_s
         double noise
         double alpha, beta
@@ -129,6 +131,7 @@ cdef bopt_params dict2structparams(dict dparams):
     params.n_iterations = dparams.get('n_iterations',params.n_iterations)
     params.n_inner_iterations = dparams.get('n_inner_iterations',
                                             params.n_inner_iterations)
+    params.n_inner_starts = dparams.get('n_inner_starts',params.n_inner_starts)
     params.n_init_samples = dparams.get('n_init_samples',params.n_init_samples)
     params.n_iter_relearn = dparams.get('n_iter_relearn',params.n_iter_relearn)
 
@@ -147,6 +150,8 @@ cdef bopt_params dict2structparams(dict dparams):
         
     name = dparams.get('surr_name',params.surr_name)
     set_surrogate(&params,name)
+    params.n_window_samples = dparams.get('n_window_samples',
+                                          params.n_window_samples)
 
     params.sigma_s = dparams.get('sigma_s',params.sigma_s)
     params.noise = dparams.get('noise',params.noise)
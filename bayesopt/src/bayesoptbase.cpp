@@ -21,6 +21,7 @@
 */
 
 #include <ctime>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
 #include "bayesopt/bayesoptbase.hpp"
 #include "bayesopt/parameters.hpp"
 
@@ -33,7 +34,7 @@
 namespace bayesopt
 {
   BayesOptBase::BayesOptBase(size_t dim, Parameters parameters):
-    mParameters(parameters), mDims(dim)
+    mParameters(parameters), mDims(dim), mLastCriteria(0.0)
   {
     // Random seed
     if (mParameters.random_seed < 0) mParameters.random_seed = std::time(0); 
@@ -300,6 +301,11 @@ namespace bayesopt
   // structure.
   ProbabilityDistribution* BayesOptBase::getPrediction(const vectord& query)
   { return mModel->getPrediction(query); };
+
+  ProbabilityDistribution* 
+  BayesOptBase::getPredictionBatch(const matrixd& queries, vectord& mean,
+				   vectord& std)
+  { return mModel->getPredictionBatch(queries,mean,std); };
   
   const Dataset* BayesOptBase::getData()
   { return mModel->getData(); };
@@ -316,9 +322,23 @@ namespace bayesopt
     else return 0.0;
   }
 
+  void BayesOptBase::evaluateCriteriaBatch(const matrixd& queries, 
+					   vectord& values)
+  {
+    mModel->evaluateCriteriaBatch(queries,values);
+    for (size_t q = 0; q < queries.size1(); ++q)
+      {
+	const vectord query = boost::numeric::ublas::row(queries,q);
+	if (!checkReachability(query)) values(q) = 0.0;
+      }
+  }
+
   size_t BayesOptBase::getCurrentIter()
   {return mCurrentIter;};
 
+  double BayesOptBase::getLastCriteriaValue()
+  {return mLastCriteria;};
+
   
 
   // PROTECTED
@@ -407,7 +427,9 @@ namespace bayesopt
 	if (mParameters.epsilon > result)
 	  {
 	    FILE_LOG(logINFO) << "Epsilon-greedy random query!";
-	    return samplePoint();
+	    const vectord Xrandom = samplePoint();
+	    mLastCriteria = evaluateCriteria(Xrandom);
+	    return Xrandom;
 	  }
       }
 
@@ -421,7 +443,7 @@ namespace bayesopt
 	mModel->setFirstCriterium();
 	while (changed)
 	  {
-	    findOptimal(Xnext);
+	    mLastCriteria = findOptimal(Xnext);
 	    changed = mModel->setNextCriterium(Xnext);
 	  }
 	std::string name = mModel->getBestCriteria(Xnext);
@@ -430,7 +452,7 @@ namespace bayesopt
     else  // Standard "Bayesian optimization"
       {
 	FILE_LOG(logDEBUG) << "------ Optimizing criteria ------";
-	findOptimal(Xnext);
+	mLastCriteria = findOptimal(Xnext);
       }
     return Xnext;
   }
@@ -22,6 +22,7 @@
 
 #include "bayesopt/bayesopt.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 
@@ -96,9 +97,45 @@ namespace bayesopt  {
     return Xnext;
   };
 
-  void ContinuousModel::findOptimal(vectord &xOpt)
+  double ContinuousModel::findOptimal(vectord &xOpt)
   { 
-    double minf = cOptimizer->run(xOpt);
+    double minf;
+    if (mParameters.n_inner_starts > 0)
+      {
+	// Local searches from the best points of a space filling design,
+	// which is screened with a single batch evaluation of the
+	// criteria, and from the best point so far.
+	const size_t nStarts = mParameters.n_inner_starts;
+	const size_t nCandidates = std::max(nStarts,
+					    mParameters.n_inner_iterations*mDims);
+	matrixd candidates(nCandidates,mDims);
+#if defined (USE_SOBOL)
+	randInt drawSeed(mEngine,intUniformDist(0,1<<20));
+	utils::sobol(candidates,drawSeed());
+#else
+	utils::lhs(candidates,mEngine);
+#endif
+	vectord values;
+	evaluateCriteriaBatch(candidates,values);
+
+	std::vector<size_t> order(nCandidates);
+	for (size_t i = 0; i < nCandidates; ++i) order[i] = i;
+	std::stable_sort(order.begin(),order.end(),
+			 [&values](size_t a, size_t b)
+			 { return values(a) < values(b); });
+
+	matrixd starts(nStarts,mDims);
+	row(starts,0) = getPointAtMinimum();
+	for (size_t i = 1; i < nStarts; ++i)
+	  {
+	    row(starts,i) = row(candidates,order[i-1]);
+	  }
+	minf = cOptimizer->runMultiStart(starts,xOpt);
+      }
+    else
+      {
+	minf = cOptimizer->run(xOpt);
+      }
 
     //Let's try some local exploration like spearmint
     randNFloat drawSample(mEngine,normalDist(0,0.001));
@@ -124,6 +161,7 @@ namespace bayesopt  {
 	    //We ignore this one
 	  }
       }
+    return minf;
   };
 
   vectord ContinuousModel::remapPoint(const vectord& x)
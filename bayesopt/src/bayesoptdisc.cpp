@@ -67,14 +67,15 @@ namespace bayesopt
     return mInputSet[sample()];
   };
 
-  void DiscreteModel::findOptimal(vectord &xOpt)
+  double DiscreteModel::findOptimal(vectord &xOpt)
   {
     std::vector<double> critv(mInputSet.size());
     std::transform(mInputSet.begin(),mInputSet.end(),critv.begin(),
 		   boost::bind(&DiscreteModel::evaluateCriteria,this,_1));
 
-    xOpt = mInputSet[std::distance(critv.begin(),
-			 std::max_element(critv.begin(),critv.end()))];
+    std::vector<double>::iterator best = std::max_element(critv.begin(),
+							  critv.end());
+    xOpt = mInputSet[std::distance(critv.begin(),best)];
     
     // xOpt = *mInputSet.begin();
     // double min = evaluateCriteria(xOpt);
@@ -89,6 +90,7 @@ namespace bayesopt
     // 	    min = current;
     // 	  }
     //   }
+    return *best;
   }
 
   //In this case, it is the trivial function
@@ -20,6 +20,7 @@
 ------------------------------------------------------------------------
 */
 
+#include <boost/numeric/ublas/matrix_proxy.hpp>
 #include "ublas_trace.hpp"
 #include "gaussian_process.hpp"
 
@@ -67,18 +68,55 @@ namespace bayesopt
 
   ProbabilityDistribution* GaussianProcess::prediction(const vectord &query)
   {
-    const double kq = computeSelfCorrelation(query);
-    const vectord kn = computeCrossCorrelation(query);
-    
-
-    vectord vd(kn);
-    inplace_solve(mL,vd,ublas::lower_tag());
-    double basisPred = mMean.muTimesFeat(query);
-    double yPred = basisPred + ublas::inner_prod(vd,mAlphaV);
-    double sPred = sqrt(mSigma*(kq - ublas::inner_prod(vd,vd)));
-    
-    d_->setMeanAndStd(yPred,sPred);
-    return d_;
+    matrixd queries(1,query.size());
+    ublas::row(queries,0) = query;
+
+    vectord mean, std;
+    return predictionBatch(queries,mean,std);
+  }
+
+
+  ProbabilityDistribution* GaussianProcess::predictionBatch(const matrixd &queries,
+							    vectord& mean,
+							    vectord& std)
+  {
+    const size_t n = mData.getNSamples();
+    const size_t m = queries.size1();
+    mean.resize(m,false);
+    std.resize(m,false);
+    if (m == 0) return NULL;
+
+    vectord kq;
+    matrixd vd;
+    computeSelfCorrelation(queries,kq);
+    computeCrossCorrelation(queries,vd);
+    solveCholeskyBlock(vd);
+
+    // Same accumulation order as the inner products of a single query
+    vectord vAlpha = zvectord(m);
+    vectord vv = zvectord(m);
+    for (size_t i = 0; i < n; ++i)
+      {
+	const double* v = &vd(i,0);
+	const double alpha = mAlphaV(i);
+	for (size_t q = 0; q < m; ++q)
+	  {
+	    vAlpha(q) += v[q] * alpha;
+	    vv(q) += v[q] * v[q];
+	  }
+      }
+
+    for (size_t q = 0; q < m; ++q)
+      {
+	const vectord query = ublas::row(queries,q);
+	const double basisPred = mMean.muTimesFeat(query);
+	mean(q) = basisPred + vAlpha(q);
+	std(q) = sqrt(mSigma*(kq(q) - vv(q)));
+      }
+
+    GaussianDistribution* d = threadDistribution(d_);
+    d->setMeanAndStd(mean(m-1),std(m-1));
+    return d;
   }
 
 
@@ -71,8 +71,9 @@ namespace bayesopt
     double sPred = sqrt( mSigma * (kq - inner_prod(v,v) 
 				   + inner_prod(rho,rho)));
 
-    d_->setMeanAndStd(yPred,sPred);
-    return d_;
+    GaussianDistribution* d = threadDistribution(d_);
+    d->setMeanAndStd(yPred,sPred);
+    return d;
   }
 
   void GaussianProcessML::precomputePrediction()
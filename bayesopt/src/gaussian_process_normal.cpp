@@ -85,8 +85,9 @@ namespace bayesopt
       }
 					
 
-    d_->setMeanAndStd(yPred,sPred);
-    return d_;
+    GaussianDistribution* d = threadDistribution(d_);
+    d->setMeanAndStd(yPred,sPred);
+    return d;
   }
 
 
@@ -0,0 +1,135 @@
+/*
+-------------------------------------------------------------------------
+   This file is part of BayesOpt, an efficient C++ library for
+   Bayesian optimization.
+
+   Copyright (C) 2011-2015 Ruben Martinez-Cantin <rmcantin@unizar.es>
+
+   BayesOpt is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Affero General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   BayesOpt is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with BayesOpt.  If not, see <http://www.gnu.org/licenses/>.
+------------------------------------------------------------------------
+*/
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "log.hpp"
+#include "gaussian_process_window.hpp"
+
+namespace bayesopt
+{
+
+  WindowData::WindowData(size_t dim, Parameters params):
+    mWindow(), mWindowMean(dim, params)
+  {}
+
+
+  GaussianProcessWindow::GaussianProcessWindow(size_t dim, Parameters params,
+					       const Dataset& data,
+					       MeanModel& mean,
+					       randEngine& eng):
+    WindowData(dim, params),
+    GaussianProcess(dim, params, mWindow, mWindowMean, eng),
+    mFullData(data), mWindowSize(params.n_window_samples),
+    mSelectedSamples(0)
+  {
+    if (mWindowSize == 0)
+      {
+	throw std::invalid_argument("The window of the surrogate function "
+				    "requires at least one sample");
+      }
+  }  // Constructor
+
+
+  GaussianProcessWindow::~GaussianProcessWindow()
+  {} // Default destructor
+
+
+  void GaussianProcessWindow::fitSurrogateModel()
+  {
+    updateWindow();
+    KernelRegressor::fitSurrogateModel();
+  }
+
+
+  void GaussianProcessWindow::updateSurrogateModel()
+  {
+    const size_t n = mFullData.getNSamples();
+    if ((n <= mWindowSize) && (mSelectedSamples + 1 == n))
+      {
+	// The window holds all the data, so the new sample is appended
+	const vectord lastX = mFullData.getLastSampleX();
+	mWindow.addSample(lastX, mFullData.getLastSampleY());
+	mWindowMean.addNewPoint(lastX);
+	mSelectedSamples = n;
+	KernelRegressor::updateSurrogateModel();
+      }
+    else
+      {
+	updateWindow();
+	KernelRegressor::fitSurrogateModel();
+      }
+  }
+
+
+  double GaussianProcessWindow::evaluate(const vectord &x)
+  {
+    updateWindow();
+    return GaussianProcess::evaluate(x);
+  }
+
+
+  void GaussianProcessWindow::updateWindow()
+  {
+    const size_t n = mFullData.getNSamples();
+    if (n == mSelectedSamples) return;
+
+    std::vector<bool> selected(n, n <= mWindowSize);
+    if (n > mWindowSize)
+      {
+	std::vector<size_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+			 [this](size_t a, size_t b)
+			 { return mFullData.mY(a) < mFullData.mY(b); });
+
+	const size_t nBest = mWindowSize / 2;
+	for (size_t i = 0; i < nBest; ++i)
+	  {
+	    selected[order[i]] = true;
+	  }
+
+	size_t nSelected = nBest;
+	for (size_t i = n; (i-- > 0) && (nSelected < mWindowSize); )
+	  {
+	    if (!selected[i])
+	      {
+		selected[i] = true;
+		++nSelected;
+	      }
+	  }
+      }
+
+    mWindow = Dataset();
+    for (size_t i = 0; i < n; ++i)
+      {
+	if (selected[i]) mWindow.addSample(mFullData.mX[i], mFullData.mY(i));
+      }
+    mWindowMean.setPoints(mWindow.mX);
+    mSelectedSamples = n;
+
+    FILE_LOG(logDEBUG) << "Surrogate window: " << mWindow.getNSamples()
+		       << " of " << n << " samples";
+  }
+
+} //namespace bayesopt
@@ -19,8 +19,11 @@
    along with BayesOpt.  If not, see <http://www.gnu.org/licenses/>.
 ------------------------------------------------------------------------
 */
+#include <algorithm>
 #include <cmath>
+#include <exception>
 #include <nlopt.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
 #include "bayesopt/parameters.h"
 #include "log.hpp"
 #include "inneroptimization.hpp"
@@ -243,6 +246,65 @@ namespace bayesopt
 
   } // innerOptimize (uBlas)
 
+  double NLOPT_Optimization::runMultiStart(const matrixd& starts, 
+					    vectord& Xnext)
+  {
+    assert(mDown.size() == starts.size2());
+    assert(mUp.size() == starts.size2());
+
+    if (rbobj == NULL)
+      {
+	throw std::invalid_argument("Wrong object model "
+				    "(gradient/no gradient)");
+      }
+
+    eval_func fpointer = &(NLOPT_Optimization::evaluate_nlopt);
+    void* objPointer = static_cast<void *>(rbobj);
+    const size_t n = starts.size2();
+    const int nStarts = static_cast<int>(starts.size1());
+    const int maxf = static_cast<int>(maxEvals);
+
+    std::vector<vectord> results(nStarts);
+    std::vector<double> fmins(nStarts);
+    std::exception_ptr error;
+
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < nStarts; ++i)
+      {
+	vectord x = boost::numeric::ublas::row(starts,i);
+	// BOBYQA may have trouble if the point is exactly at the limit.
+	for (size_t j = 0; j < n; ++j) 
+	  {
+	    x(j) = std::min(std::max(x(j),mDown[j]+0.0001),mUp[j]-0.0001);
+	  }
+	try
+	  {
+	    fmins[i] = run_nlopt(nlopt::LN_BOBYQA,fpointer,x,maxf,
+				 mDown,mUp,objPointer);
+	  }
+	catch(...)
+	  {
+#pragma omp critical(inner_multistart_error)
+	    error = std::current_exception();
+	  }
+	results[i] = x;
+      }
+    if (error) std::rethrow_exception(error);
+
+    // Reduction in the order of the starts, so the result does not
+    // depend on the number of threads.
+    int best = 0;
+    for (int i = 1; i < nStarts; ++i)
+      {
+	if (fmins[i] < fmins[best]) best = i;
+      }
+    Xnext = results[best];
+
+    FILE_LOG(logDEBUG) << "Multi-start " << nStarts << "x" << maxf 
+		       << "-> " << Xnext << " f() ->" << fmins[best];
+    return fmins[best];
+  } // runMultiStart
+
   double NLOPT_Optimization::evaluate_nlopt (unsigned int n, const double *x,
 					     double *grad, void *my_func_data)
 
@@ -75,6 +75,25 @@ namespace bayesopt
       }
   }
 
+  void KernelRegressor::solveCholeskyBlock(matrixd& block)
+  {
+    const size_t n = block.size1();
+    const size_t m = block.size2();
+    if (m == 0) return;
+    for (size_t i = 0; i < n; ++i)
+      {
+	double* vi = &block(i,0);
+	const double lii = mL(i,i);
+	for (size_t q = 0; q < m; ++q) vi[q] /= lii;
+	for (size_t j = i+1; j < n; ++j)
+	  {
+	    double* vj = &block(j,0);
+	    const double lji = mL(j,i);
+	    for (size_t q = 0; q < m; ++q) vj[q] -= lji * vi[q];
+	  }
+      }
+  }
+
   matrixd KernelRegressor::computeDerivativeCorrMatrix(int dth_index)
   {
     const size_t nSamples = mData.getNSamples();
@@ -21,12 +21,14 @@
 */
 
 #include <stdexcept>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
 
 #include "log.hpp"
 
 #include "gaussian_process.hpp"
 #include "gaussian_process_ml.hpp"
 #include "gaussian_process_normal.hpp"
+#include "gaussian_process_window.hpp"
 #include "student_t_process_jef.hpp"
 #include "student_t_process_nig.hpp"
 
@@ -46,6 +48,26 @@ namespace bayesopt
   NonParametricProcess::~NonParametricProcess(){}
 
 
+  ProbabilityDistribution* 
+  NonParametricProcess::predictionBatch(const matrixd &queries, 
+					vectord& mean, vectord& std)
+  {
+    const size_t m = queries.size1();
+    mean.resize(m,false);
+    std.resize(m,false);
+
+    ProbabilityDistribution* d = NULL;
+    for (size_t q = 0; q < m; ++q)
+      {
+	const vectord query = boost::numeric::ublas::row(queries,q);
+	d = prediction(query);
+	mean(q) = d->getMean();
+	std(q) = d->getStd();
+      }
+    return d;
+  }
+
+
   NonParametricProcess* NonParametricProcess::create(size_t dim, 
 						     Parameters parameters, 
 						     const Dataset& data, 
@@ -62,6 +84,8 @@ namespace bayesopt
       s_ptr = new GaussianProcessML(dim,parameters,data,mean,eng);
     else  if(!name.compare("sGaussianProcessNormal"))
       s_ptr = new GaussianProcessNormal(dim,parameters,data,mean,eng);
+    else  if(!name.compare("sGaussianProcessWindow"))
+      s_ptr = new GaussianProcessWindow(dim,parameters,data,mean,eng);
     else if (!name.compare("sStudentTProcessJef"))
       s_ptr = new StudentTProcessJeffreys(dim,parameters,data,mean,eng); 
     else if (!name.compare("sStudentTProcessNIG"))
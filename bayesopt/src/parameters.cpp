@@ -45,6 +45,7 @@ const size_t DEFAULT_ITERATIONS         = 190;
 const size_t DEFAULT_INIT_SAMPLES       = 10;
 const size_t DEFAULT_ITERATIONS_RELEARN = 50;
 const size_t DEFAULT_INNER_EVALUATIONS  = 500; /**< Used per dimmension */
+const size_t DEFAULT_WINDOW_SAMPLES     = 200;
 
 /* Logging and Files */
 const size_t DEFAULT_VERBOSE           = 1;
@@ -169,6 +170,7 @@ bopt_params initialize_parameters_to_default(void)
 
   params.n_iterations       = DEFAULT_ITERATIONS;
   params.n_inner_iterations = DEFAULT_INNER_EVALUATIONS;
+  params.n_inner_starts     = 0;
   params.n_init_samples     = DEFAULT_INIT_SAMPLES;
   params.n_iter_relearn     = DEFAULT_ITERATIONS_RELEARN;
 
@@ -188,6 +190,7 @@ bopt_params initialize_parameters_to_default(void)
   params.surr_name = new char[128];
   //  strcpy(params.surr_name,"sStudentTProcessNIG");
   strcpy(params.surr_name,SURR_NAME.c_str());
+  params.n_window_samples = DEFAULT_WINDOW_SAMPLES;
 
   params.sigma_s = DEFAULT_SIGMA;
   params.noise   = DEFAULT_NOISE;
@@ -250,6 +253,7 @@ namespace bayesopt {
         kernel(), mean(), crit_params(){
         n_iterations = c_params.n_iterations;
         n_inner_iterations = c_params.n_inner_iterations;
+        n_inner_starts = c_params.n_inner_starts;
         n_init_samples = c_params.n_init_samples;
         n_iter_relearn = c_params.n_iter_relearn;
         
@@ -264,6 +268,7 @@ namespace bayesopt {
         save_filename = std::string(c_params.save_filename);
         
         surr_name = std::string(c_params.surr_name);
+        n_window_samples = c_params.n_window_samples;
         sigma_s = c_params.sigma_s;
         
         noise = c_params.noise;
@@ -300,6 +305,7 @@ namespace bayesopt {
       bopt_params c_params = initialize_parameters_to_default();
       c_params.n_iterations = n_iterations;
       c_params.n_inner_iterations = n_inner_iterations;
+      c_params.n_inner_starts = n_inner_starts;
       c_params.n_init_samples = n_init_samples;
       c_params.n_iter_relearn = n_iter_relearn;
         
@@ -314,6 +320,7 @@ namespace bayesopt {
       strcpy(c_params.save_filename, save_filename.c_str());
         
       strcpy(c_params.surr_name, surr_name.c_str());
+      c_params.n_window_samples = n_window_samples;
       c_params.sigma_s = sigma_s;
         
       c_params.noise = noise;
@@ -381,6 +388,7 @@ namespace bayesopt {
     void Parameters::init_default(){
         n_iterations = DEFAULT_ITERATIONS;
         n_inner_iterations = DEFAULT_INNER_EVALUATIONS;
+        n_inner_starts = 0;
         n_init_samples = DEFAULT_INIT_SAMPLES;
         n_iter_relearn = DEFAULT_ITERATIONS_RELEARN;
         
@@ -395,6 +403,7 @@ namespace bayesopt {
         save_filename = SAVE_FILENAME;
         
         surr_name = SURR_NAME;
+        n_window_samples = DEFAULT_WINDOW_SAMPLES;
         
         sigma_s = DEFAULT_SIGMA;
         noise = DEFAULT_NOISE;
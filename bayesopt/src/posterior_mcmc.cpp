@@ -19,6 +19,9 @@
    along with BayesOpt.  If not, see <http://www.gnu.org/licenses/>.
 ------------------------------------------------------------------------
 */
+#include <algorithm>
+#include <exception>
+#include <limits>
 #include "log.hpp"
 #include "posterior_mcmc.hpp"
 
@@ -26,7 +29,8 @@ namespace bayesopt
 {
   MCMCModel::MCMCModel(size_t dim, Parameters parameters, 
 		       randEngine& eng):
-    PosteriorModel(dim,parameters,eng), nParticles(10)
+    PosteriorModel(dim,parameters,eng), nParticles(10),
+    mIsSampled(false), mtRandom(eng)
   {
     //TODO: Take nParticles from parameters
     
@@ -42,29 +46,108 @@ namespace bayesopt
     kSampler.reset(new MCMCSampler(&mGP[0],nhp,eng));
 
     kSampler->setNParticles(nParticles);
-    kSampler->setNBurnOut(100);
+    const size_t nBurnOut = 100;
+    kSampler->setNBurnOut(nBurnOut);
+
+    setChainSamplers(nBurnOut + nParticles);
   }
 
   MCMCModel::~MCMCModel()
   { } // Default destructor
 
 
+  template <typename Function>
+  void MCMCModel::forEachParticle(Function function)
+  {
+    // Learning the mean parameters or scoring by cross validation
+    // writes the mean model, which all the particles share.
+    const bool isMeanShared = mParameters.l_all || mParameters.sc_type == SC_LOOCV;
+    std::exception_ptr error;
+    const int n = static_cast<int>(nParticles);
+#pragma omp parallel for schedule(dynamic) if(!isMeanShared)
+    for(int i = 0; i < n; ++i)
+      {
+	try
+	  {
+	    function(static_cast<size_t>(i));
+	  }
+	catch(...)
+	  {
+#pragma omp critical(mcmc_particle_error)
+	    error = std::current_exception();
+	  }
+      }
+    if (error) std::rethrow_exception(error);
+  }
+
+  void MCMCModel::fitSurrogateModel()
+  { 
+    forEachParticle([this](size_t i){ mGP[i].fitSurrogateModel(); });
+  }
+
+  void MCMCModel::updateSurrogateModel()
+  {     
+    forEachParticle([this](size_t i){ mGP[i].updateSurrogateModel(); });
+  }
+
+
   void MCMCModel::updateHyperParameters()
   {
-    // We take the initial point as the last particle from previous update.
-    size_t last = mGP.size()-1;
-    vectord lastTheta = mGP[last].getHyperParameters();
+    if (!mIsSampled)
+      {
+	// The first time, a single long chain is needed to move from
+	// the initial point to the posterior.
+	size_t last = mGP.size()-1;
+	vectord lastTheta = mGP[last].getHyperParameters();
+
+	FILE_LOG(logDEBUG) << "Initial kernel parameters: " << lastTheta;
+	kSampler->run(lastTheta);
+	for(size_t i = 0; i<nParticles; ++i)
+	  {
+	    mGP[i].setHyperParameters(kSampler->getParticle(i));
+	  }
+	FILE_LOG(logDEBUG) << "Final kernel parameters: " << lastTheta;
+	mIsSampled = true;
+	return;
+      }
 
-    FILE_LOG(logDEBUG) << "Initial kernel parameters: " << lastTheta;
-    kSampler->run(lastTheta);
+    // Afterwards, the particles are already close to the posterior,
+    // so each of them is moved by its own short chain. The engines
+    // are seeded sequentially, so the particles do not depend on the
+    // number of threads.
+    randInt seed(mtRandom, intUniformDist(0,std::numeric_limits<int>::max()));
+    std::vector<vectord> theta(nParticles);
     for(size_t i = 0; i<nParticles; ++i)
       {
-	mGP[i].setHyperParameters(kSampler->getParticle(i));
+	mChainEngines[i].seed(static_cast<unsigned int>(seed()));
+	theta[i] = mGP[i].getHyperParameters();
       }
-    FILE_LOG(logDEBUG) << "Final kernel parameters: " << lastTheta;	
+
+    forEachParticle([this, &theta](size_t i)
+      {
+	mChainSamplers[i].run(theta[i]);
+	mGP[i].setHyperParameters(mChainSamplers[i].getParticle(0));
+      });
   };
 
 
+  void MCMCModel::setChainSamplers(size_t nSteps)
+  {
+    // The chains together do as many steps as the single chain
+    const size_t chainLength = std::max<size_t>(nSteps / nParticles, 1);
+    const size_t nhp = mGP[0].nHyperParameters();
+
+    mChainEngines.resize(nParticles);
+    for(size_t i = 0; i<nParticles; ++i)
+      {
+	mChainSamplers.push_back(new MCMCSampler(&mGP[i],nhp,
+						 mChainEngines[i]));
+	mChainSamplers[i].setNParticles(1);
+	mChainSamplers[i].setNBurnOut(chainLength - 1);
+      }
+  } // setChainSamplers
+
+
   void MCMCModel::setSurrogateModel(randEngine& eng)
   {
     for(size_t i = 0; i<nParticles; ++i)
@@ -57,24 +57,22 @@ namespace bayesopt
   {
     clock_t start = clock();
     double kq = computeSelfCorrelation(query);
-    //    vectord kn = computeCrossCorrelation(query);
-    mKernel.computeCrossCorrelation(mData.mX,query,mKn);
+    vectord kn = computeCrossCorrelation(query);
     vectord phi = mMean.getFeatures(query);
   
-    //    vectord v(mKn);
-    inplace_solve(mL,mKn,ublas::lower_tag());
+    inplace_solve(mL,kn,ublas::lower_tag());
 
-    vectord rho = phi - prod(mKn,mKF);
+    vectord rho = phi - prod(kn,mKF);
 
-    //    vectord rho(rq);
     inplace_solve(mL2,rho,ublas::lower_tag());
     
-    double yPred = inner_prod(phi,mWML) + inner_prod(mKn,mAlphaF);
-    double sPred = sqrt( mSigma * (kq - inner_prod(mKn,mKn) 
+    double yPred = inner_prod(phi,mWML) + inner_prod(kn,mAlphaF);
+    double sPred = sqrt( mSigma * (kq - inner_prod(kn,kn) 
 				   + inner_prod(rho,rho)));
 
-    d_->setMeanAndStd(yPred,sPred);
-    return d_;
+    StudentTDistribution* d = threadDistribution(d_);
+    d->setMeanAndStd(yPred,sPred);
+    return d;
   }
 
   void StudentTProcessJeffreys::precomputePrediction()
@@ -82,8 +80,6 @@ namespace bayesopt
     size_t n = mData.getNSamples();
     size_t p = mMean.nFeatures();
 
-    mKn.resize(n);
-
     mKF = trans(mMean.mFeatM);
     inplace_solve(mL,mKF,ublas::lower_tag());
 
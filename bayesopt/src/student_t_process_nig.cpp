@@ -83,8 +83,9 @@ namespace bayesopt
       }
 					
 
-    d_->setMeanAndStd(yPred,sPred);
-    return d_;
+    StudentTDistribution* d = threadDistribution(d_);
+    d->setMeanAndStd(yPred,sPred);
+    return d;
   }
 
 
@@ -0,0 +1,171 @@
+/*
+-------------------------------------------------------------------------
+   This file is part of BayesOpt, an efficient C++ library for 
+   Bayesian optimization.
+
+   Copyright (C) 2011-2015 Ruben Martinez-Cantin <rmcantin@unizar.es>
+ 
+   BayesOpt is free software: you can redistribute it and/or modify it 
+   under the terms of the GNU Affero General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   BayesOpt is distributed in the hope that it will be useful, but 
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with BayesOpt.  If not, see <http://www.gnu.org/licenses/>.
+------------------------------------------------------------------------
+*/
+
+#include <cmath>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include "testfunctions.hpp"
+#include "lhs.hpp"
+#include "prob_distribution.hpp"
+#include "dataset.hpp"
+#include "kernel_functors.hpp"
+#include "mean_functors.hpp"
+#include "ublas_cholesky.hpp"
+
+/*
+ * Batch predictions and criteria evaluations have to be equal to the
+ * single point ones. As the single point prediction of the Gaussian
+ * process is computed by the batch one, both are also compared with
+ * the prediction computed point by point from an explicit Cholesky
+ * solve of the kernel matrix.
+ */
+int checkKernel(const std::string& kernel, const std::string& criteria,
+		learning_type learning)
+{
+  bayesopt::Parameters params;
+  params.verbose_level = 0;
+  params.random_seed = 0;
+  params.n_init_samples = 15;
+  params.kernel.name = kernel;
+  params.crit_name = criteria;
+  params.l_type = learning;
+
+  BraninNormalized branin(params);
+  branin.initializeOptimization();
+  for (size_t i = 0; i < 5; ++i)
+    {
+      branin.stepOptimization();
+    }
+
+  randEngine eng(0);
+  matrixd queries(200,2);
+  bayesopt::utils::lhs(queries,eng);
+
+  vectord mean, std, values;
+  branin.getPredictionBatch(queries,mean,std);
+  branin.evaluateCriteriaBatch(queries,values);
+
+  int returnValue = 0;
+  for (size_t q = 0; q < queries.size1(); ++q)
+    {
+      const vectord query = boost::numeric::ublas::row(queries,q);
+      const double value = branin.evaluateCriteria(query);
+      bayesopt::ProbabilityDistribution* d = branin.getPrediction(query);
+      if (d->getMean() != mean(q) || d->getStd() != std(q) || value != values(q))
+	{
+	  std::cout << "ERROR: " << kernel << " " << criteria << " at " << query
+		    << ": single " << d->getMean() << " " << d->getStd() << " " << value
+		    << ", batch " << mean(q) << " " << std(q) << " " << values(q)
+		    << std::endl;
+	  returnValue = -1;
+	  break;
+	}
+    }
+  return returnValue;
+}
+
+/* With fixed hyperparameters, the kernel and the mean of the
+ * surrogate are the ones built from the parameters. */
+int checkReference(const std::string& kernel)
+{
+  bayesopt::Parameters params;
+  params.verbose_level = 0;
+  params.random_seed = 0;
+  params.n_init_samples = 15;
+  params.kernel.name = kernel;
+  params.l_type = L_FIXED;
+
+  BraninNormalized branin(params);
+  branin.initializeOptimization();
+  for (size_t i = 0; i < 5; ++i)
+    {
+      branin.stepOptimization();
+    }
+
+  const bayesopt::Dataset* data = branin.getData();
+  const size_t n = data->getNSamples();
+  bayesopt::KernelModel kernelModel(2,params);
+  bayesopt::MeanModel meanModel(2,params);
+
+  matrixd K(n,n), L(n,n);
+  kernelModel.computeCorrMatrix(data->mX,K,params.noise);
+  bayesopt::utils::cholesky_decompose(K,L);
+
+  vectord alpha(n);
+  for (size_t i = 0; i < n; ++i)
+    {
+      alpha(i) = data->mY(i) - meanModel.muTimesFeat(data->mX[i]);
+    }
+  boost::numeric::ublas::inplace_solve(L,alpha,boost::numeric::ublas::lower_tag());
+
+  randEngine eng(1);
+  matrixd queries(200,2);
+  bayesopt::utils::lhs(queries,eng);
+
+  vectord mean, std;
+  branin.getPredictionBatch(queries,mean,std);
+
+  int returnValue = 0;
+  for (size_t q = 0; q < queries.size1(); ++q)
+    {
+      const vectord query = boost::numeric::ublas::row(queries,q);
+      vectord v = kernelModel.computeCrossCorrelation(data->mX,query);
+      boost::numeric::ublas::inplace_solve(L,v,boost::numeric::ublas::lower_tag());
+      const double refMean = meanModel.muTimesFeat(query) + inner_prod(v,alpha);
+      const double refStd = std::sqrt(params.sigma_s *
+				      (kernelModel.computeSelfCorrelation(query) - inner_prod(v,v)));
+
+      bayesopt::ProbabilityDistribution* d = branin.getPrediction(query);
+      const double tolerance = 1e-8;
+      if (std::fabs(mean(q) - refMean) > tolerance || std::fabs(std(q) - refStd) > tolerance ||
+	  std::fabs(d->getMean() - refMean) > tolerance || std::fabs(d->getStd() - refStd) > tolerance)
+	{
+	  std::cout << "ERROR: " << kernel << " reference at " << query
+		    << ": reference " << refMean << " " << refStd
+		    << ", single " << d->getMean() << " " << d->getStd()
+		    << ", batch " << mean(q) << " " << std(q) << std::endl;
+	  returnValue = -1;
+	  break;
+	}
+    }
+  return returnValue;
+}
+
+int main()
+{
+  int returnValue = 0;
+  returnValue |= checkKernel("kMaternARD5","cEI",L_EMPIRICAL);
+  returnValue |= checkKernel("kMaternARD5","cEI",L_MCMC);
+  returnValue |= checkKernel("kMaternISO3","cLCB",L_EMPIRICAL);
+  returnValue |= checkKernel("kMaternARD1","cEI",L_FIXED);
+  returnValue |= checkKernel("kSEARD","cEI",L_EMPIRICAL);
+  returnValue |= checkKernel("kSEISO","cLCB",L_FIXED);
+  returnValue |= checkKernel("kMaternISO1","cPOI",L_FIXED);
+  returnValue |= checkReference("kMaternARD5");
+  returnValue |= checkReference("kSEISO");
+
+  if (returnValue == 0)
+    {
+      std::cout << "Tests completed without errors" << std::endl;
+    }
+  return returnValue;
+}
@@ -48,6 +48,7 @@ namespace bayesopt
     void ParamLoader::loadOrSave(utils::FileParser &fp, Parameters &par){
         fp.readOrWrite("n_iterations", par.n_iterations);
         fp.readOrWrite("n_inner_iterations", par.n_inner_iterations);
+        fp.readOrWrite("n_inner_starts", par.n_inner_starts);
         fp.readOrWrite("n_init_samples", par.n_init_samples);
         fp.readOrWrite("n_iter_relearn", par.n_iter_relearn);
         fp.readOrWrite("init_method", par.init_method);
@@ -58,6 +59,7 @@ namespace bayesopt
         fp.readOrWrite("load_filename", par.load_filename);
         fp.readOrWrite("save_filename", par.save_filename);
         fp.readOrWrite("surr_name", par.surr_name);
+        fp.readOrWrite("n_window_samples", par.n_window_samples);
         fp.readOrWrite("sigma_s", par.sigma_s);
         fp.readOrWrite("noise", par.noise);
         fp.readOrWrite("alpha", par.alpha);
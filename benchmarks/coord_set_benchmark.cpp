@@ -0,0 +1,117 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 19/10/2026.
+//
+
+// Micro-benchmark of insertion and lookup of coordinates in CoordSet and in std::unordered_set with the hash that was
+// used before it.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../source/pattern/coord_set.h"
+
+struct legacy_coord_hash {
+    unsigned int operator()(const coord &x) const {
+        return (int) x.x * (int) x.x - (int) x.y;
+    }
+};
+
+using legacy_coord_set = std::unordered_set<coord, legacy_coord_hash>;
+
+std::vector<coord> filledSquare(int size) {
+    std::vector<coord> coordinates;
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            coordinates.emplace_back(i, j);
+        }
+    }
+    return coordinates;
+}
+
+std::vector<coord> straightLines(int length, int lines) {
+    std::vector<coord> coordinates;
+    for (int line = 0; line < lines; line++) {
+        for (int i = 0; i < length; i++) {
+            coordinates.emplace_back(i, 3 * line);
+            coordinates.emplace_back(3 * line, i);
+        }
+    }
+    return coordinates;
+}
+
+/// Nanoseconds per coordinate of inserting all coordinates, and then of looking up each of them and its neighbour
+template<typename Set>
+std::pair<double, double> benchmark(const std::vector<coord> &coordinates, int repetitions) {
+    double insertion_ns = 0;
+    double lookup_ns = 0;
+    size_t found = 0;
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        Set set;
+        for (auto &coordinate: coordinates) {
+            set.insert(coordinate);
+        }
+        std::chrono::steady_clock::time_point inserted = std::chrono::steady_clock::now();
+        for (auto &coordinate: coordinates) {
+            found += set.find(coordinate) != set.end();
+            found += set.find(coordinate + coord{1, 1}) != set.end();
+        }
+        std::chrono::steady_clock::time_point looked_up = std::chrono::steady_clock::now();
+        insertion_ns += std::chrono::duration<double, std::nano>(inserted - begin).count();
+        lookup_ns += std::chrono::duration<double, std::nano>(looked_up - inserted).count();
+    }
+    if (found == 0) {
+        std::cout << "No coordinates found." << std::endl;
+    }
+    double operations = (double) coordinates.size() * repetitions;
+    return {insertion_ns / operations, lookup_ns / operations / 2};
+}
+
+void printBenchmark(const std::string &name, const std::vector<coord> &coordinates, int repetitions) {
+    std::pair<double, double> legacy = benchmark<legacy_coord_set>(coordinates, repetitions);
+    std::pair<double, double> flat = benchmark<CoordSet>(coordinates, repetitions);
+    std::cout << name << " (" << coordinates.size() << " coordinates)" << std::endl
+              << "\tunordered_set: " << legacy.first << " ns/insert, " << legacy.second << " ns/lookup" << std::endl
+              << "\tCoordSet:      " << flat.first << " ns/insert, " << flat.second << " ns/lookup" << std::endl;
+}
+
+int main() {
+    // Sizes of a perimeter or splay line and of a whole large pattern, the latter not fitting in the cache
+    for (int size: {200, 1000}) {
+        int repetitions = 40000000 / (size * size);
+        std::vector<coord> square = filledSquare(size);
+        printBenchmark("Filled square", square, repetitions);
+
+        std::vector<coord> shuffled_square = square;
+        std::shuffle(shuffled_square.begin(), shuffled_square.end(), std::mt19937(0));
+        printBenchmark("Shuffled filled square", shuffled_square, repetitions);
+
+        printBenchmark("Straight lines", straightLines(2 * size, size / 20), repetitions);
+    }
+    return 0;
+}
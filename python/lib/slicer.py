@@ -80,4 +80,14 @@ class Slicer:
                 :return:
                 """
         input_name = slicer_setup.convert_pattern_name_into_input_name(pattern)
-        self.slicer.slice_pattern_variable_width(input_name, seeds)
\ No newline at end of file
+        self.slicer.slice_pattern_variable_width(input_name, seeds)
+
+    def re_score(self, pattern: str | Pattern):
+        """
+        Ranks the generating parameters evaluated during prior optimisations using the current disagreement function.
+        Requires the evaluation cache to be enabled in disagreement.cfg.
+        :param pattern:
+        :return:
+        """
+        input_name = slicer_setup.convert_pattern_name_into_input_name(pattern)
+        self.slicer.re_score_pattern(input_name)
\ No newline at end of file
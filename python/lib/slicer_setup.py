@@ -52,6 +52,7 @@ def configure_slicer(slicer):
     slicer.re_slice_pattern.argtypes = [ctypes.c_char_p]
     slicer.slice_pattern_seeds_only.argtypes = [ctypes.c_char_p, ctypes.c_int]
     slicer.slice_pattern_variable_width.argtypes = [ctypes.c_char_p, ctypes.c_int]
+    slicer.re_score_pattern.argtypes = [ctypes.c_char_p]
 
 
 def import_slicer(build_directory=None):
@@ -30,16 +30,24 @@
 #include <string>
 #include <iomanip>
 #include <chrono>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#if defined(__linux__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
 
 #include "bayesian_optimisation.h"
 #include "vector_slicer_config.h"
 #include "pattern/path_sorting/nearest_neighbour.h"
 #include "pattern/path_sorting/seed_line.h"
 #include "pattern/importing_and_exporting/open_files.h"
+#include "pattern/importing_and_exporting/pattern_snapshot.h"
 #include "pattern/importing_and_exporting/exporting.h"
 #include "pattern/auxiliary/progress_bar.h"
 #include "pattern/simulation/configuration_reading.h"
 #include "dataset.hpp"
+#include "bopt_state.hpp"
 
 namespace fs = boost::filesystem;
 
@@ -75,11 +83,64 @@ double BayesianOptimisation::evaluateSample(const vectord &x_in) {
     problem = QuantifiedConfig(problem, x_in);
     double disagreement = problem.getDisagreement(seeds, threads, is_disagreement_details_printed,
                                                   disagreement_percentile);
+    updateBestCandidates(problem.getConfig(), disagreement, problem.getSeedMetrics());
+    if (journal) {
+        journal->append(problem.getConfig(), problem.getSeedMetrics());
+    }
     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
     evaluation_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    evaluation_count++;
     return disagreement;
 }
 
+void BayesianOptimisation::setDeadline(std::chrono::steady_clock::time_point optimisation_deadline) {
+    deadline = optimisation_deadline;
+}
+
+bool BayesianOptimisation::isWithinTimeLimit(int evaluations) const {
+    if (deadline == std::chrono::steady_clock::time_point::max()) {
+        return true;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (evaluation_count == 0) {
+        return now < deadline;
+    }
+    // Seeds of a single evaluation are filled in parallel, same as the seeds of the final scan.
+    double evaluation_ns = (double) evaluation_time_ns / evaluation_count;
+    double final_scan_ns = evaluation_ns * problem.getFinalSeeds() / seeds;
+    auto required_time = std::chrono::nanoseconds((long long) (evaluation_ns * evaluations + final_scan_ns));
+    return now + required_time < deadline;
+}
+
+void BayesianOptimisation::updateBestCandidates(const FillingConfig &config, double disagreement,
+                                                const std::vector<FillMetrics> &seed_metrics) {
+    if (best_candidates.size() >= KEPT_CANDIDATES_COUNT && disagreement >= best_candidates.back().disagreement) {
+        return;
+    }
+    auto position = std::upper_bound(best_candidates.begin(), best_candidates.end(), disagreement,
+                                     [](double value, const EvaluatedCandidate &candidate) {
+                                         return value < candidate.disagreement;
+                                     });
+    best_candidates.insert(position, {config, disagreement, seed_metrics});
+    if (best_candidates.size() > KEPT_CANDIDATES_COUNT) {
+        best_candidates.pop_back();
+    }
+}
+
+void BayesianOptimisation::setJournal(std::shared_ptr<OptimisationJournal> optimisation_journal) {
+    journal = std::move(optimisation_journal);
+}
+
+std::vector<FillMetrics> BayesianOptimisation::getCandidateSeedMetrics(const FillingConfig &config) const {
+    uint64_t parameters_key = CachedEvaluation(0, config, {}).getParametersKey();
+    for (const EvaluatedCandidate &candidate: best_candidates) {
+        if (CachedEvaluation(0, candidate.config, {}).getParametersKey() == parameters_key) {
+            return candidate.seed_metrics;
+        }
+    }
+    return {};
+}
+
 void
 BayesianOptimisation::showProgress(int current_step, int max_step, int steps_from_improvement, int steps_threshold,
                                    int step_offset) {
@@ -139,8 +200,64 @@ stack(const std::vector<std::vector<double>> &target, const std::vector<double>
 }
 
 
+void BayesianOptimisation::setPriorSamples(std::vector<vectord> normalised_x, std::vector<double> y) {
+    prior_x = std::move(normalised_x);
+    prior_y = std::move(y);
+}
+
+void BayesianOptimisation::setReferenceSamples(std::vector<vectord> normalised_x) {
+    reference_x = std::move(normalised_x);
+}
+
+bool BayesianOptimisation::isPriorSample(const std::vector<double> &normalised_sample) const {
+    for (const vectord &sample: prior_x) {
+        bool is_matching = true;
+        for (int i = 0; i < normalised_sample.size(); i++) {
+            // Prior samples are read back from configs, so they are only accurate to their printed precision.
+            is_matching = is_matching && std::fabs(sample[i] - normalised_sample[i]) < 1e-4;
+        }
+        if (is_matching) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BayesianOptimisation::initializeWithPriorSamples() {
+    std::cout << "Warm-starting the optimisation with " << prior_x.size() << " previously evaluated samples and "
+              << reference_x.size() << " samples of reference patterns." << std::endl;
+    bayesopt::BOptState state;
+    state.mParameters = mParameters;
+    state.mCurrentIter = 0;
+    state.mCounterStuck = 0;
+    state.mYPrev = 0;
+    state.mX = prior_x;
+    std::vector<double> y_values = prior_y;
+
+    for (const vectord &x_sample: reference_x) {
+        if (isPriorSample(std::vector<double>(x_sample.begin(), x_sample.end()))) {
+            continue;
+        }
+        state.mX.emplace_back(x_sample);
+        y_values.emplace_back(evaluateSampleInternal(x_sample));
+    }
+
+    // Surrogate model needs at least as many samples as the initial design would provide.
+    while (state.mX.size() < mParameters.n_init_samples) {
+        vectord x_sample = samplePoint();
+        state.mX.emplace_back(x_sample);
+        y_values.emplace_back(evaluateSampleInternal(x_sample));
+    }
+    state.mY = vectord(y_values.size());
+    std::copy(y_values.begin(), y_values.end(), state.mY.begin());
+    restoreOptimization(state);
+}
+
 void BayesianOptimisation::evaluateGuesses(const std::vector<std::vector<double>> &fixed_guesses) {
     for (const std::vector<double> &guess: fixed_guesses) {
+        if (isPriorSample(guess)) {
+            continue;
+        }
         vectord x_sample(guess.size());
         for (int i = 0; i < guess.size(); i++) {
             x_sample[i] = guess[i];
@@ -150,9 +267,14 @@ void BayesianOptimisation::evaluateGuesses(const std::vector<std::vector<double>
 }
 
 void BayesianOptimisation::optimizeControlled(vectord &x_out, int max_steps, int max_constant_steps,
+                                              double expected_improvement_fraction, int max_low_improvement_steps,
                                               const std::vector<std::vector<double>> &fixed_guesses) {
     std::cout << "Evaluating the pattern for initial samples." << std::endl;
-    initializeOptimization();
+    if (prior_x.empty() && reference_x.empty()) {
+        initializeOptimization();
+    } else {
+        initializeWithPriorSamples();
+    }
     evaluateGuesses(fixed_guesses);
     if (max_steps <= 0 && max_constant_steps <= 0) {
         throw std::runtime_error(
@@ -160,10 +282,18 @@ void BayesianOptimisation::optimizeControlled(vectord &x_out, int max_steps, int
                 "number_of_improvement_iterations needs to be greater than zero.");
     }
     int steps_since_improvement = 0;
+    int low_improvement_steps = 0;
     int i = 0;
     while (true) {
         double minimal_disagreement = getValueAtMinimum();
         stepOptimization();
+        // The criterion is the negative expected improvement of the chosen generating parameters
+        double expected_improvement = -getLastCriteriaValue();
+        if (expected_improvement < expected_improvement_fraction * std::abs(minimal_disagreement)) {
+            low_improvement_steps++;
+        } else {
+            low_improvement_steps = 0;
+        }
         vectord best_configuration = bayesopt::ContinuousModel::remapPoint(getData()->getPointAtMinimum());
         double current_disagreement = getData()->getLastSampleY();
         if (current_disagreement < minimal_disagreement) {
@@ -184,15 +314,91 @@ void BayesianOptimisation::optimizeControlled(vectord &x_out, int max_steps, int
             std::cout << "\rIdeal filling found after " << mCurrentIter << " steps. Finishing optimisation."
                       << std::endl;
             break;
+        } else if (!isWithinTimeLimit(1)) {
+            std::cout << "\rRemaining time is left for the final seed scan after " << mCurrentIter
+                      << " steps. Finishing optimisation." << std::endl;
+            break;
+        } else if (expected_improvement_fraction > 0 && low_improvement_steps >= max_low_improvement_steps) {
+            std::cout << "\rExpected improvement stayed below " << expected_improvement_fraction
+                      << " of the minimal disagreement for " << low_improvement_steps << " steps after " << mCurrentIter
+                      << " steps. Finishing optimisation." << std::endl;
+            break;
         }
         i++;
         if (max_steps > 0 && i >= max_steps) {
+            std::cout << "\rNumber of iterations reached after " << mCurrentIter << " steps. Finishing optimisation."
+                      << std::endl;
             break;
         }
     }
     x_out = getFinalResult();
 }
 
+void BayesianOptimisation::refineResult(vectord &x_out, double stencil_step) {
+    vectord incumbent = getData()->getPointAtMinimum();
+    double incumbent_disagreement = getValueAtMinimum();
+
+    std::vector<vectord> stencil;
+    for (int i = 0; i < dims; i++) {
+        for (double direction: {-1., 1.}) {
+            vectord neighbour = incumbent;
+            neighbour[i] = std::clamp(incumbent[i] + direction * stencil_step, 0., 1.);
+            if (neighbour[i] != incumbent[i]) {
+                stencil.emplace_back(neighbour);
+            }
+        }
+    }
+    if (!isWithinTimeLimit((int) stencil.size())) {
+        std::cout << "Refinement skipped to leave time for the final seed scan." << std::endl;
+        return;
+    }
+    std::vector<QuantifiedConfig> neighbours;
+    for (const vectord &neighbour: stencil) {
+        neighbours.emplace_back(problem, bayesopt::ContinuousModel::remapPoint(neighbour));
+    }
+
+    // All seeds of all neighbours are evaluated in a single parallel loop.
+    int neighbour_count = (int) neighbours.size();
+    std::vector<std::vector<double>> disagreements(neighbour_count, std::vector<double>(seeds));
+    std::vector<std::vector<FillMetrics>> metrics(neighbour_count, std::vector<FillMetrics>(seeds));
+    omp_set_num_threads(threads);
+#pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < neighbour_count * seeds; k++) {
+        int neighbour = k / seeds;
+        int seed = k % seeds;
+        QuantifiedConfig seed_config(neighbours[neighbour], seed);
+        seed_config.evaluateWithCache();
+        disagreements[neighbour][seed] = seed_config.getDisagreement();
+        metrics[neighbour][seed] = seed_config.getMetrics();
+    }
+    if (problem.getEvaluationCache()) {
+        problem.getEvaluationCache()->save();
+    }
+
+    int best_neighbour = -1;
+    double best_disagreement = incumbent_disagreement;
+    for (int i = 0; i < neighbour_count; i++) {
+        double disagreement = percentileDisagreement(disagreements[i], disagreement_percentile);
+        updateBestCandidates(neighbours[i].getConfig(), disagreement, metrics[i]);
+        if (journal) {
+            journal->append(neighbours[i].getConfig(), metrics[i]);
+        }
+        if (disagreement < best_disagreement) {
+            best_disagreement = disagreement;
+            best_neighbour = i;
+        }
+    }
+
+    std::cout << "Refinement evaluated " << neighbour_count << " neighbouring sets of generating parameters. ";
+    if (best_neighbour >= 0) {
+        x_out = bayesopt::ContinuousModel::remapPoint(stencil[best_neighbour]);
+        std::cout << "Minimal disagreement improved from " << incumbent_disagreement << " to " << best_disagreement
+                  << "." << std::endl;
+    } else {
+        std::cout << "Minimal disagreement " << incumbent_disagreement << " was not improved." << std::endl;
+    }
+}
+
 long BayesianOptimisation::getEvaluationTimeNs() const {
     return evaluation_time_ns;
 }
@@ -318,13 +524,108 @@ void exportPatterns(const std::vector<QuantifiedConfig> &patterns, const fs::pat
     exportRowToFile(patterns[0].getDirectorDisagreementDistribution(), bucketed_disagreement);
 }
 
+/// Opens the evaluation cache of the pattern if it is enabled in the disagreement config.
+std::shared_ptr<EvaluationCache>
+openEvaluationCache(const DesiredPattern &desired_pattern, const Simulation &simulation,
+                    const std::string &pattern_name) {
+    if (!simulation.isEvaluationCacheUsed()) {
+        return nullptr;
+    }
+    createDirectory(OUTPUT_PATH);
+    fs::path cache_path = createPathWithExtension(EVALUATION_CACHE_PATH, pattern_name, ".bin");
+    return std::make_shared<EvaluationCache>(cache_path, desired_pattern.getContentHash());
+}
+
+/// Opens the pattern and prepares the structures used by the seeding method, reusing the snapshot of the prepared
+/// pattern if it is enabled in the disagreement config.
+DesiredPattern openPattern(const fs::path &pattern_path, const Simulation &simulation, fillingMethod seeding_method) {
+    DesiredPattern desired_pattern;
+    if (simulation.isPatternCacheUsed()) {
+        createDirectory(OUTPUT_PATH);
+        fs::path snapshot_path = createPathWithExtension(PATTERN_CACHE_PATH, pattern_path.filename().string(),
+                                                         ".bin");
+        desired_pattern = openPatternFromDirectory(pattern_path, simulation.getThreads(), simulation, seeding_method,
+                                                   snapshot_path);
+    } else {
+        desired_pattern = openPatternFromDirectory(pattern_path, simulation.getThreads(), simulation);
+        desired_pattern.prepareSeeding(seeding_method);
+    }
+    desired_pattern.printMemoryUsage();
+    return desired_pattern;
+}
+
+/// Converts previous evaluations into normalised samples of the optimisation, rescored using the current disagreement
+/// function. Only evaluations that share the non-optimised parameters with the filling config and lie within the bounds
+/// are used.
+void findPriorSamples(const std::vector<CachedEvaluation> &evaluations, const QuantifiedConfig &pattern,
+                      const FillingConfig &filling_config, const vecd &lower_bound, const vecd &upper_bound,
+                      std::vector<vectord> &prior_x, std::vector<double> &prior_y) {
+    std::vector<RescoredParameters> rescored_parameters =
+            rescoreEvaluations(evaluations, pattern, pattern.getOptimisationSeeds());
+
+    for (const RescoredParameters &rescored: rescored_parameters) {
+        const CachedEvaluation &parameters = rescored.parameters;
+        bool is_matching = parameters.filling_method == filling_config.getInitialSeedingMethod() &&
+                           parameters.step_length == filling_config.getStepLength() &&
+                           parameters.print_radius == filling_config.getPrintRadius() &&
+                           parameters.repulsion_radius == filling_config.getRepulsionRadius();
+        vecd sample;
+        auto add_parameter = [&](bool is_optimised, double value, double config_value) {
+            if (is_optimised) {
+                sample.emplace_back(value);
+            } else {
+                is_matching = is_matching && value == config_value;
+            }
+        };
+        add_parameter(pattern.isCollisionRadiusOptimised(), parameters.collision_radius,
+                      filling_config.getTerminationRadius());
+        add_parameter(pattern.isStartingPointSeparationOptimised(), parameters.starting_point_separation,
+                      filling_config.getSeedSpacing());
+        add_parameter(pattern.isRepulsionMagnitudeOptimised(), parameters.repulsion,
+                      filling_config.getRepulsion());
+        add_parameter(pattern.isRepulsionAngleOptimised(), parameters.repulsion_angle,
+                      filling_config.getRepulsionAngle());
+        if (!is_matching) {
+            continue;
+        }
+        std::reverse(sample.begin(), sample.end());
+
+        vectord normalised_sample(sample.size());
+        bool is_within_bounds = true;
+        for (int i = 0; i < sample.size(); i++) {
+            normalised_sample[i] = (sample[i] - lower_bound[i]) / (upper_bound[i] - lower_bound[i]);
+            is_within_bounds = is_within_bounds && normalised_sample[i] >= 0 && normalised_sample[i] <= 1;
+        }
+        if (is_within_bounds) {
+            prior_x.emplace_back(normalised_sample);
+            prior_y.emplace_back(rescored.disagreement);
+        }
+    }
+}
+
+/// Exports the disagreements of the samples in the order of their evaluation, in the format of the bayesopt state file
+/// which is read when plotting the optimisation sequence
+void exportOptimisationSequence(const vectord &disagreements, const fs::path &path) {
+    std::ofstream file(path.string());
+    file << "mY=[" << disagreements.size() << "](";
+    for (size_t i = 0; i < disagreements.size(); i++) {
+        file << (i == 0 ? "" : ",") << disagreements[i];
+    }
+    file << ")" << std::endl;
+}
+
 QuantifiedConfig
 bayesianOptimisationCore(const DesiredPattern &desired_pattern, FillingConfig filling_config,
-                         const Simulation &simulation,
-                         bayesopt::Parameters optimisation_parameters, int dims, double &filling_duration_ns) {
+                         const Simulation &simulation, const std::shared_ptr<EvaluationCache> &evaluation_cache,
+                         const std::shared_ptr<OptimisationJournal> &journal, const fs::path &sequence_path,
+                         bayesopt::Parameters optimisation_parameters, int dims, double &filling_duration_ns,
+                         std::chrono::steady_clock::time_point deadline) {
 
     QuantifiedConfig pattern(desired_pattern, filling_config, simulation);
+    pattern.setEvaluationCache(evaluation_cache);
     BayesianOptimisation pattern_optimisation(pattern, std::move(optimisation_parameters), dims);
+    pattern_optimisation.setJournal(journal);
+    pattern_optimisation.setDeadline(deadline);
 
     double print_radius = filling_config.getPrintRadius();
     vecd lower_bound_vector;
@@ -377,33 +678,86 @@ bayesianOptimisationCore(const DesiredPattern &desired_pattern, FillingConfig fi
     }
 
     pattern_optimisation.setBoundingBox(lower_bound, upper_bound);
+    std::vector<CachedEvaluation> prior_evaluations = journal->takeEvaluations();
+    // The cache is only a warm start when resuming, so that a fresh optimisation keeps its random initial design.
+    if (pattern.getEvaluationCache() && pattern.isOptimisationResumed()) {
+        std::vector<CachedEvaluation> cached_evaluations = pattern.getEvaluationCache()->getEvaluations();
+        prior_evaluations.insert(prior_evaluations.end(), cached_evaluations.begin(), cached_evaluations.end());
+    }
+    if (!prior_evaluations.empty()) {
+        std::vector<vectord> prior_x;
+        std::vector<double> prior_y;
+        findPriorSamples(prior_evaluations, pattern, filling_config, lower_bound_vector, upper_bound_vector,
+                         prior_x, prior_y);
+        pattern_optimisation.setPriorSamples(prior_x, prior_y);
+    }
+    if (!pattern.getReferencePatterns().empty() && pattern.getReferenceSamples() > 0) {
+        std::vector<CachedEvaluation> reference_evaluations;
+        for (const std::string &reference_name: pattern.getReferencePatterns()) {
+            fs::path reference_path = createPathWithExtension(OPTIMISATION_EXPORT_PATH, reference_name, ".journal");
+            std::vector<CachedEvaluation> evaluations = OptimisationJournal::readEvaluations(reference_path);
+            if (evaluations.empty()) {
+                std::cout << "No evaluations of the reference pattern " << reference_name << " were found."
+                          << std::endl;
+            }
+            reference_evaluations.insert(reference_evaluations.end(), evaluations.begin(), evaluations.end());
+        }
+        std::vector<vectord> matching_x;
+        std::vector<double> matching_y;
+        findPriorSamples(reference_evaluations, pattern, filling_config, lower_bound_vector, upper_bound_vector,
+                         matching_x, matching_y);
+
+        // Samples are sorted by their disagreement, and the same parameters may be found in multiple references.
+        std::vector<vectord> reference_x;
+        for (const vectord &sample: matching_x) {
+            if ((int) reference_x.size() >= pattern.getReferenceSamples()) {
+                break;
+            }
+            bool is_repeated = std::any_of(reference_x.begin(), reference_x.end(), [&sample](const vectord &other) {
+                return std::equal(sample.begin(), sample.end(), other.begin());
+            });
+            if (!is_repeated) {
+                reference_x.emplace_back(sample);
+            }
+        }
+        pattern_optimisation.setReferenceSamples(reference_x);
+    }
     int max_iterations = pattern.getTotalIterations();
     int max_iterations_without_improvement = pattern.getImprovementIterations();
     try {
         pattern_optimisation.optimizeControlled(best_config, max_iterations, max_iterations_without_improvement,
-                                                fixed_guesses);
+                                                pattern.getExpectedImprovementFraction(),
+                                                pattern.getLowExpectedImprovementIterations(), fixed_guesses);
+        if (pattern.getRefinementStep() > 0) {
+            pattern_optimisation.refineResult(best_config, pattern.getRefinementStep());
+        }
     } catch (std::runtime_error &error) {
         if (error.what() == std::string("nlopt failure")) {
             std::cout << std::endl;
             std::cout << "WARNING: NLOPT failure during bayesian optimisation. Returned solution may not be optimal."
                       << std::endl;
-            return {pattern, best_config};
         } else {
             throw error;
         }
     }
+    exportOptimisationSequence(pattern_optimisation.getData()->mY, sequence_path);
     filling_duration_ns = (double) pattern_optimisation.getEvaluationTimeNs();
-    return {pattern, best_config};
+    QuantifiedConfig best_pattern(pattern, best_config);
+    best_pattern.setSeedMetrics(pattern_optimisation.getCandidateSeedMetrics(best_pattern.getConfig()));
+    return best_pattern;
 }
 
 QuantifiedConfig bayesianOptimisation(
         const DesiredPattern &desired_pattern, FillingConfig filling_config,
-        const Simulation &simulation, std::string pattern_name) {
+        const Simulation &simulation, std::string pattern_name,
+        const std::shared_ptr<EvaluationCache> &evaluation_cache, std::chrono::steady_clock::time_point deadline) {
 
     QuantifiedConfig best_pattern(desired_pattern, filling_config, simulation);
+    best_pattern.setEvaluationCache(evaluation_cache);
 
     fs::path optimisation_log_path = createTxtPath(LOGS_EXPORT_PATH, pattern_name);
-    fs::path optimisation_save_path = createTxtPath(OPTIMISATION_EXPORT_PATH, pattern_name);
+    fs::path journal_path = createPathWithExtension(OPTIMISATION_EXPORT_PATH, pattern_name, ".journal");
+    fs::path sequence_path = createTxtPath(OPTIMISATION_EXPORT_PATH, pattern_name);
 
     bayesopt::Parameters parameters;
     parameters.random_seed = 0;
@@ -413,9 +767,15 @@ QuantifiedConfig bayesianOptimisation(
     parameters.n_iter_relearn = best_pattern.getRelearningIterations();
     parameters.noise = best_pattern.getNoise();
     parameters.n_inner_iterations = 100;
+    parameters.n_inner_starts = best_pattern.getAcquisitionStarts();
+    if (best_pattern.getSurrogateWindow() > 0) {
+        parameters.surr_name = "sGaussianProcessWindow";
+        parameters.n_window_samples = best_pattern.getSurrogateWindow();
+    }
 
-    parameters.load_save_flag = 2;
-    parameters.save_filename = optimisation_save_path.string();
+    // Samples are stored in the optimisation journal instead, as bayesopt rewrites its whole state every iteration. Only
+    // the sequence of disagreements is exported once the optimisation finishes.
+    parameters.load_save_flag = 0;
 
     parameters.verbose_level = best_pattern.getPrintVerbose();
     parameters.log_filename = optimisation_log_path.string();
@@ -430,8 +790,11 @@ QuantifiedConfig bayesianOptimisation(
         std::cout << "No parameter was chosen for optimisation. Optimising only over seeds. \n"
                      "You can enable optimisation_parameters in bayesian_configuration.cfg" << std::endl;
     } else {
-        best_pattern = bayesianOptimisationCore(desired_pattern, filling_config, simulation,
-                                                parameters, dims, filling_duration_ns);
+        auto journal = std::make_shared<OptimisationJournal>(journal_path, desired_pattern.getContentHash(),
+                                                             simulation.isOptimisationResumed());
+        best_pattern = bayesianOptimisationCore(desired_pattern, filling_config, simulation, evaluation_cache,
+                                                journal, sequence_path, parameters, dims, filling_duration_ns,
+                                                deadline);
     }
 
     return best_pattern;
@@ -443,14 +806,23 @@ std::vector<QuantifiedConfig> optimisation(
         ) {
     std::cout << "\n\nCurrent directory: " << pattern_path << std::endl;
     std::string pattern_name = pattern_path.filename().string();
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    if (simulation.getTimeLimit() > 0) {
+        deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(simulation.getTimeLimit()));
+    }
 
+    std::shared_ptr<EvaluationCache> evaluation_cache = openEvaluationCache(desired_pattern, simulation,
+                                                                            pattern_name);
     QuantifiedConfig best_pattern(desired_pattern, filling_config, simulation);
+    best_pattern.setEvaluationCache(evaluation_cache);
     if (is_bayesian_optimisation_enabled) {
-        best_pattern = bayesianOptimisation(desired_pattern, filling_config, simulation, pattern_name);
+        best_pattern = bayesianOptimisation(desired_pattern, filling_config, simulation, pattern_name,
+                                            evaluation_cache, deadline);
     }
 
     std::vector<QuantifiedConfig> best_fills = best_pattern.findBestSeeds(best_pattern.getFinalSeeds(),
-                                                                          best_pattern.getThreads());
+                                                                          best_pattern.getThreads(), deadline);
 
     exportPatterns(best_fills, pattern_path, simulation);
 
@@ -459,6 +831,72 @@ std::vector<QuantifiedConfig> optimisation(
     return best_fills;
 }
 
+/// Physical memory of the machine in bytes, or 0 if it cannot be measured on the current platform
+double physicalMemory() {
+#if defined(__linux__) || defined(__APPLE__)
+    return (double) sysconf(_SC_PHYS_PAGES) * (double) sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+/// Times fills of the pattern with doubling number of threads, each filling one seed, and returns the number of threads
+/// with the highest throughput. Threads are limited so that their fills take at most half of the physical memory, or
+/// to the number of processors if it cannot be measured.
+int tuneThreads(const DesiredPattern &desired_pattern, const FillingConfig &filling_config,
+                const Simulation &simulation) {
+    QuantifiedConfig template_config(desired_pattern, filling_config, simulation);
+    int max_threads = omp_get_num_procs();
+
+    QuantifiedConfig single_fill(template_config, 0);
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    // Islands of the pattern are filled on the same thread, so that the baseline is a single-threaded fill.
+    single_fill.evaluate(1);
+    double single_fill_duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    // The fields of the islands are merged into the fields of the pattern, so both are held at the peak of the fill.
+    double memory_per_fill = 2 * (double) single_fill.getAllocatedBytes();
+    if (physicalMemory() > 0) {
+        max_threads = std::max(1, std::min(max_threads, (int) (physicalMemory() / 2 / memory_per_fill)));
+    }
+
+    int best_threads = 1;
+    double best_throughput = 1 / single_fill_duration;
+    for (int threads = 2; threads <= max_threads; threads = std::min(2 * threads, max_threads)) {
+        std::vector<QuantifiedConfig> calibration_fills;
+        for (int seed = 0; seed < threads; seed++) {
+            calibration_fills.emplace_back(template_config, seed);
+        }
+        begin = std::chrono::steady_clock::now();
+        omp_set_num_threads(threads);
+#pragma omp parallel for
+        for (int i = 0; i < threads; i++) {
+            calibration_fills[i].evaluate();
+        }
+        double throughput = threads / std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        // Additional threads have to pay for the memory bandwidth they take from the others
+        if (throughput > 1.05 * best_throughput) {
+            best_threads = threads;
+            best_throughput = throughput;
+        } else if (throughput < 0.9 * best_throughput) {
+            break;
+        }
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    std::cout << "Threads tuned to " << best_threads << " out of " << omp_get_num_procs() << " processors: "
+              << best_throughput << " fills/s, "
+              << single_fill_duration * 1000 << " ms and " << memory_per_fill / 1024 / 1024
+              << " MB per single-threaded fill." << std::endl;
+    if (simulation.getOptimisationSeeds() % best_threads != 0) {
+        std::cout << "\tNumber of seeds " << simulation.getOptimisationSeeds()
+                  << " is not a multiple of the number of threads, so some threads idle in each evaluation."
+                  << std::endl;
+    }
+    return best_threads;
+}
+
 void setupDirectories(const fs::path &pattern_path) {
     createDirectory(pattern_path.parent_path().parent_path() / "output");
     createDirectory(LOGS_EXPORT_PATH);
@@ -473,8 +911,10 @@ void optimisePattern(const fs::path &pattern_path, bool is_default_used, bool is
     fs::path initial_config_path = pattern_path / "config.txt";
     FillingConfig initial_config(initial_config_path);
 
-    DesiredPattern desired_pattern = openPatternFromDirectory(pattern_path,
-                                                              simulation.getThreads(), simulation);
+    DesiredPattern desired_pattern = openPattern(pattern_path, simulation, initial_config.getInitialSeedingMethod());
+    if (simulation.isThreadsTuned()) {
+        simulation.setTunedThreads(tuneThreads(desired_pattern, initial_config, simulation));
+    }
 
     optimisation(desired_pattern, initial_config, simulation, pattern_path, is_bayesian_optimisation_enabled);
     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
@@ -493,8 +933,8 @@ void fillPattern(const fs::path &pattern_path, const fs::path &config_path) {
 
     Simulation simulation(pattern_path, true);
     std::vector<FillingConfig> optimised_configs = readMultiSeedConfig(config_path);
-    DesiredPattern desired_pattern = openPatternFromDirectory(pattern_path,
-                                                              simulation.getThreads(), simulation);
+    DesiredPattern desired_pattern = openPattern(pattern_path, simulation,
+                                                 optimised_configs[0].getInitialSeedingMethod());
     std::vector<QuantifiedConfig> filled_configs;
     for (int i = 0; i < 10; i++) {
         filled_configs.emplace_back(desired_pattern, optimised_configs[i], simulation);
@@ -517,8 +957,10 @@ void optimisePatternSeeds(const fs::path &pattern_path, const fs::path &config_p
 
     Simulation simulation(pattern_path, true);
     FillingConfig optimised_config = readMultiSeedConfig(config_path)[0];
-    DesiredPattern desired_pattern = openPatternFromDirectory(pattern_path, simulation.getThreads(), simulation);
+    DesiredPattern desired_pattern = openPattern(pattern_path, simulation, optimised_config.getInitialSeedingMethod());
     QuantifiedConfig best_pattern(desired_pattern, optimised_config, simulation);
+    best_pattern.setEvaluationCache(
+            openEvaluationCache(desired_pattern, simulation, pattern_path.filename().string()));
 
     std::vector<QuantifiedConfig> best_fills = best_pattern.findBestSeeds(seeds, best_pattern.getThreads());
 
@@ -537,8 +979,10 @@ void variableWidthOptimisation(const fs::path &pattern_path, int seeds) {
     FillingConfig optimised_config(config_path);
     optimised_config.convertToVariableWidth();
 
-    DesiredPattern desired_pattern = openPatternFromDirectory(pattern_path, simulation.getThreads(), simulation);
+    DesiredPattern desired_pattern = openPattern(pattern_path, simulation, optimised_config.getInitialSeedingMethod());
     QuantifiedConfig best_pattern(desired_pattern, optimised_config, simulation);
+    best_pattern.setEvaluationCache(
+            openEvaluationCache(desired_pattern, simulation, pattern_path.filename().string()));
 
     std::vector<QuantifiedConfig> best_fills = best_pattern.findBestSeeds(seeds, best_pattern.getThreads());
 
@@ -554,4 +998,69 @@ void recalculateBestConfig(const fs::path &pattern_path) {
     fs::path config_path =
             pattern_path.parent_path().parent_path() / "output" / "best_configs" / (pattern_name + ".txt");
     fillPattern(pattern_path, config_path);
-}
\ No newline at end of file
+}
+
+void rescorePattern(const fs::path &pattern_path) {
+    std::cout << "\n\nCurrent directory: " << pattern_path << std::endl;
+    std::string pattern_name = pattern_path.filename().string();
+    createDirectory(OUTPUT_PATH);
+    fs::path cache_path = createPathWithExtension(EVALUATION_CACHE_PATH, pattern_name, ".bin");
+    if (!fs::exists(cache_path)) {
+        throw std::runtime_error("No evaluation cache of the pattern exists. Optimise the pattern with "
+                                 "is_evaluation_cache_used enabled first.");
+    }
+    Simulation simulation(pattern_path, true);
+    // Only the evaluations of the current inputs of the pattern are ranked. Their hash is taken from the snapshot of the
+    // prepared pattern when it is up to date, so that the pattern is opened only without one.
+    fs::path snapshot_path = createPathWithExtension(PATTERN_CACHE_PATH, pattern_name, ".bin");
+    uint64_t pattern_hash = 0;
+    if (!readPatternSnapshotContentHash(snapshot_path, patternSnapshotKey(pattern_path, simulation), pattern_hash)) {
+        pattern_hash = openPatternFromDirectory(pattern_path, simulation.getThreads(), simulation).getContentHash();
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::vector<CachedEvaluation> evaluations = readCachedEvaluations(cache_path);
+    if (evaluations.empty()) {
+        throw std::runtime_error("Evaluation cache of the pattern is empty.");
+    }
+    evaluations.erase(std::remove_if(evaluations.begin(), evaluations.end(), [pattern_hash](auto &evaluation) {
+        return evaluation.pattern_hash != pattern_hash;
+    }), evaluations.end());
+    if (evaluations.empty()) {
+        throw std::runtime_error("Evaluation cache holds no evaluations of the current inputs of the pattern. "
+                                 "Optimise the pattern again first.");
+    }
+    std::vector<RescoredParameters> rescored_parameters = rescoreEvaluations(evaluations, simulation,
+                                                                             simulation.getOptimisationSeeds());
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    double duration_ms = (double) std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() / 1000;
+
+    std::cout << "Rescored " << evaluations.size() << " evaluations of " << rescored_parameters.size()
+              << " sets of generating parameters in " << duration_ms << " ms." << std::endl;
+    if (rescored_parameters.empty()) {
+        return;
+    }
+
+    fs::path rescored_path = createCsvPath(RESCORED_EXPORT_PATH, pattern_name);
+    std::ofstream file(rescored_path.string());
+    file << "Disagreement,TerminationRadius,SeedSpacing,Repulsion,RepulsionAngle,BestSeed,BestSeedDisagreement";
+    for (const RescoredParameters &rescored: rescored_parameters) {
+        auto best_seed = std::min_element(rescored.seed_disagreements.begin(), rescored.seed_disagreements.end());
+        file << "\n" << rescored.disagreement << "," << rescored.parameters.collision_radius << ","
+             << rescored.parameters.starting_point_separation << "," << rescored.parameters.repulsion << ","
+             << rescored.parameters.repulsion_angle << "," << best_seed - rescored.seed_disagreements.begin() << ","
+             << *best_seed;
+    }
+    file.close();
+
+    std::stringstream stream;
+    stream << std::setprecision(3);
+    stream << "\tDisagreement\tColRad\tSep\tRep\tRepAng" << std::endl;
+    for (int i = 0; i < rescored_parameters.size() && i < simulation.getNumberOfLayers(); i++) {
+        const CachedEvaluation &parameters = rescored_parameters[i].parameters;
+        stream << "\t" << rescored_parameters[i].disagreement << "\t\t" << parameters.collision_radius << "\t"
+               << parameters.starting_point_separation << "\t" << parameters.repulsion << "\t"
+               << parameters.repulsion_angle << std::endl;
+    }
+    std::cout << stream.str() << "Ranking exported to " << rescored_path << std::endl;
+}
@@ -28,6 +28,17 @@
 #include "bayesopt/bayesopt.hpp"
 #include <utility>
 #include "pattern/quantified_config.h"
+#include "optimisation_journal.h"
+
+/// Number of the best evaluated generating parameters whose per-seed metrics are kept during the optimisation.
+#define KEPT_CANDIDATES_COUNT 4
+
+/// Generating parameters evaluated during the optimisation together with the metrics of each of their seeds.
+struct EvaluatedCandidate {
+    FillingConfig config;
+    double disagreement;
+    std::vector<FillMetrics> seed_metrics;
+};
 
 /// \brief The main class responsible for the optimisation of the problem. The QuantifiedConfig contains all the information
 /// about the DesiredPattern and the DisagreementWeights that will be used for optimisation.
@@ -40,6 +51,16 @@ class BayesianOptimisation : public bayesopt::ContinuousModel {
     bool is_disagreement_details_printed = false;
     double disagreement_percentile = 0.5;
     long evaluation_time_ns = 0;
+    int evaluation_count = 0;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    /// Normalised generating parameters and disagreements of samples known before the optimisation
+    std::vector<vectord> prior_x;
+    std::vector<double> prior_y;
+    /// Normalised generating parameters of related patterns, which are evaluated instead of the initial design
+    std::vector<vectord> reference_x;
+    /// Best evaluated candidates, sorted by their disagreement
+    std::vector<EvaluatedCandidate> best_candidates;
+    std::shared_ptr<OptimisationJournal> journal;
 public:
     long getEvaluationTimeNs() const;
 
@@ -58,14 +79,48 @@ private:
     bool checkReachability(const vectord &query) { return true; };
 
     void evaluateGuesses(const std::vector<std::vector<double>>& fixed_guesses);
+
+    /// Initialises the surrogate model with prior and reference samples instead of the initial design
+    void initializeWithPriorSamples();
+
+    bool isPriorSample(const std::vector<double> &normalised_sample) const;
+
+    void updateBestCandidates(const FillingConfig &config, double disagreement,
+                              const std::vector<FillMetrics> &seed_metrics);
+
+    /// Whether the number of evaluations of generating parameters followed by the final seed scan are expected to
+    /// finish before the deadline, based on the average duration of the previous evaluations
+    bool isWithinTimeLimit(int evaluations) const;
 public:
 
     BayesianOptimisation(QuantifiedConfig problem, bayesopt::Parameters parameters, int dims);
 
 
-    /// Optimizes the pattern with a threshold on number of steps without improvement
+    /// Sets samples evaluated before the optimisation (e.g. in a previous run), which are used to warm-start it
+    void setPriorSamples(std::vector<vectord> normalised_x, std::vector<double> y);
+
+    /// Sets the best samples of related patterns, which are evaluated first and replace the initial design
+    void setReferenceSamples(std::vector<vectord> normalised_x);
+
+    /// Sets the time by which the optimisation and the final seed scan should finish
+    void setDeadline(std::chrono::steady_clock::time_point optimisation_deadline);
+
+    /// Sets the journal to which every evaluated set of generating parameters is appended
+    void setJournal(std::shared_ptr<OptimisationJournal> optimisation_journal);
+
+    /// Returns the per-seed metrics of the generating parameters if they are among the best evaluated candidates
+    std::vector<FillMetrics> getCandidateSeedMetrics(const FillingConfig &config) const;
+
+    /// Optimizes the pattern with a threshold on number of steps without improvement and on number of steps in which
+    /// the expected improvement is below a fraction of the minimal disagreement
     void optimizeControlled(vectord &x_out, int max_steps, int max_constant_steps,
+                            double expected_improvement_fraction, int max_low_improvement_steps,
                             const std::vector<std::vector<double>>& fixed_guesses);
+
+    /// Evaluates the neighbours of the best generating parameters, displaced by stencil_step of the range along each
+    /// parameter, in parallel using the same seeds. x_out is replaced by the best neighbour if it has lower
+    /// disagreement than the best generating parameters.
+    void refineResult(vectord &x_out, double stencil_step);
 };
 
 /// Optimises the pattern from the selected path using the set configuration
@@ -85,4 +140,8 @@ void optimisePatternSeeds(const fs::path &pattern_path, const fs::path &config_p
 
 /// Same as optimise PatternSeeds, but uses the config from the pattern path.
 void variableWidthOptimisation(const fs::path &pattern_path, int seeds);
+
+/// Ranks the generating parameters stored in the evaluation cache for the current inputs of the pattern using the
+/// current disagreement function.
+void rescorePattern(const fs::path &pattern_path);
 #endif //VECTOR_SLICER_BAYESIAN_OPTIMISATION_H
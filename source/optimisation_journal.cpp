@@ -0,0 +1,225 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 18/10/2026.
+//
+
+#include "optimisation_journal.h"
+#include "pattern/auxiliary/hashing.h"
+
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+#define OPTIMISATION_JOURNAL_MAGIC 0x4A4F5356 // "VSOJ"
+#define OPTIMISATION_JOURNAL_VERSION 1
+
+
+uint64_t checksum(const std::string &payload) {
+    StableHash hash;
+    hash.add(payload.data(), payload.size());
+    return hash.getHash();
+}
+
+std::string serialiseRecord(const std::vector<CachedEvaluation> &record) {
+    std::ostringstream payload_stream;
+    auto count = (uint32_t) record.size();
+    payload_stream.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (const CachedEvaluation &evaluation: record) {
+        writeEvaluation(payload_stream, evaluation);
+    }
+    std::string payload = payload_stream.str();
+
+    auto payload_size = (uint32_t) payload.size();
+    uint64_t payload_checksum = checksum(payload);
+    std::string record_bytes;
+    record_bytes.append(reinterpret_cast<const char *>(&payload_size), sizeof(payload_size));
+    record_bytes.append(reinterpret_cast<const char *>(&payload_checksum), sizeof(payload_checksum));
+    record_bytes.append(payload);
+    return record_bytes;
+}
+
+/// Reads a single record. Returns false at the end of the journal or at the first incomplete or corrupted record.
+bool deserialiseRecord(std::istream &stream, std::vector<CachedEvaluation> &record) {
+    uint32_t payload_size = 0;
+    uint64_t payload_checksum = 0;
+    stream.read(reinterpret_cast<char *>(&payload_size), sizeof(payload_size));
+    stream.read(reinterpret_cast<char *>(&payload_checksum), sizeof(payload_checksum));
+    if (!stream) {
+        return false;
+    }
+    // The size of a corrupted record must not be trusted before it is known to fit in the rest of the journal.
+    std::streampos payload_start = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    std::streamoff remaining_bytes = stream.tellg() - payload_start;
+    stream.seekg(payload_start);
+    if (payload_size > remaining_bytes) {
+        return false;
+    }
+    std::string payload(payload_size, '\0');
+    stream.read(&payload[0], payload_size);
+    if (stream.gcount() != payload_size || checksum(payload) != payload_checksum) {
+        return false;
+    }
+
+    std::istringstream payload_stream(payload);
+    uint32_t count = 0;
+    payload_stream.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!payload_stream || count > payload_size) {
+        return false;
+    }
+    record.resize(count);
+    for (CachedEvaluation &evaluation: record) {
+        if (!readEvaluation(payload_stream, evaluation)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void writeJournalHeader(std::ofstream &file, uint64_t pattern_hash) {
+    auto magic = (uint32_t) OPTIMISATION_JOURNAL_MAGIC;
+    auto version = (uint32_t) OPTIMISATION_JOURNAL_VERSION;
+    file.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+    file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char *>(&pattern_hash), sizeof(pattern_hash));
+}
+
+
+OptimisationJournal::OptimisationJournal(fs::path journal_path, uint64_t pattern_hash, bool is_resumed) :
+        journal_path(std::move(journal_path)),
+        pattern_hash(pattern_hash) {
+    if (is_resumed && readJournal()) {
+        file.open(this->journal_path.string(), std::ios::binary | std::ios::app);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open optimisation journal " + this->journal_path.string() + ".");
+        }
+    } else {
+        compact();
+    }
+}
+
+/// Reads the header of the journal. Returns false if the journal has incompatible format.
+bool readJournalHeader(std::ifstream &journal, uint64_t &journal_pattern_hash) {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    journal.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    journal.read(reinterpret_cast<char *>(&version), sizeof(version));
+    journal.read(reinterpret_cast<char *>(&journal_pattern_hash), sizeof(journal_pattern_hash));
+    return journal && magic == OPTIMISATION_JOURNAL_MAGIC && version == OPTIMISATION_JOURNAL_VERSION;
+}
+
+
+bool OptimisationJournal::readJournal() {
+    std::ifstream journal(journal_path.string(), std::ios::binary);
+    if (!journal.is_open()) {
+        return false;
+    }
+    uint64_t journal_pattern_hash = 0;
+    if (!readJournalHeader(journal, journal_pattern_hash)) {
+        std::cout << "Optimisation journal " << journal_path << " has incompatible format and will be started anew."
+                  << std::endl;
+        return false;
+    }
+    if (journal_pattern_hash != pattern_hash) {
+        std::cout << "Optimisation journal belongs to a different version of the pattern and will be started anew."
+                  << std::endl;
+        return false;
+    }
+
+    // Repeated samples are skipped, and reading stops at a record truncated by an interrupted run.
+    bool is_intact = true;
+    std::vector<CachedEvaluation> record;
+    while (journal.peek() != EOF) {
+        if (!deserialiseRecord(journal, record)) {
+            is_intact = false;
+            break;
+        }
+        if (record.empty() || !parameters_keys.insert(record.front().getParametersKey()).second) {
+            is_intact = false;
+            continue;
+        }
+        records.emplace_back(record);
+    }
+    std::cout << "Resuming optimisation from " << records.size() << " journal records." << std::endl;
+    return is_intact;
+}
+
+void OptimisationJournal::compact() {
+    // The journal is replaced atomically, so that it is never left partially written.
+    fs::path temporary_path = journal_path;
+    temporary_path += ".tmp";
+    std::ofstream temporary_file(temporary_path.string(), std::ios::binary | std::ios::trunc);
+    writeJournalHeader(temporary_file, pattern_hash);
+    for (const std::vector<CachedEvaluation> &record: records) {
+        std::string record_bytes = serialiseRecord(record);
+        temporary_file.write(record_bytes.data(), (std::streamsize) record_bytes.size());
+    }
+    temporary_file.close();
+    if (!temporary_file) {
+        throw std::runtime_error("Unable to write optimisation journal " + temporary_path.string() + ".");
+    }
+    fs::rename(temporary_path, journal_path);
+
+    file.open(journal_path.string(), std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open optimisation journal " + journal_path.string() + ".");
+    }
+}
+
+void OptimisationJournal::append(const FillingConfig &config, const std::vector<FillMetrics> &seed_metrics) {
+    std::vector<CachedEvaluation> record;
+    record.reserve(seed_metrics.size());
+    for (int seed = 0; seed < seed_metrics.size(); seed++) {
+        FillingConfig seed_config(config, seed);
+        record.emplace_back(pattern_hash, seed_config, seed_metrics[seed]);
+    }
+    if (record.empty() || !parameters_keys.insert(record.front().getParametersKey()).second) {
+        return;
+    }
+    std::string record_bytes = serialiseRecord(record);
+    file.write(record_bytes.data(), (std::streamsize) record_bytes.size());
+    file.flush();
+}
+
+std::vector<CachedEvaluation> OptimisationJournal::takeEvaluations() {
+    std::vector<CachedEvaluation> evaluations;
+    for (const std::vector<CachedEvaluation> &record: records) {
+        evaluations.insert(evaluations.end(), record.begin(), record.end());
+    }
+    records.clear();
+    records.shrink_to_fit();
+    return evaluations;
+}
+
+std::vector<CachedEvaluation> OptimisationJournal::readEvaluations(const fs::path &journal_path) {
+    std::vector<CachedEvaluation> evaluations;
+    std::ifstream journal(journal_path.string(), std::ios::binary);
+    uint64_t journal_pattern_hash = 0;
+    if (!journal.is_open() || !readJournalHeader(journal, journal_pattern_hash)) {
+        return evaluations;
+    }
+    std::vector<CachedEvaluation> record;
+    while (journal.peek() != EOF && deserialiseRecord(journal, record)) {
+        evaluations.insert(evaluations.end(), record.begin(), record.end());
+    }
+    return evaluations;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 18/10/2026.
+//
+
+#ifndef VECTOR_SLICER_OPTIMISATION_JOURNAL_H
+#define VECTOR_SLICER_OPTIMISATION_JOURNAL_H
+
+#include <fstream>
+#include <unordered_set>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+#include "pattern/evaluation_cache.h"
+
+namespace fs = boost::filesystem;
+
+/// \brief Append-only journal of the generating parameters evaluated during Bayesian optimisation, together with the
+/// metrics of each of their seeds. Every record is written with its length and checksum and flushed, so a run that is
+/// interrupted loses at most the record being written. The journal is only rewritten when it is opened, and only if
+/// it has a truncated or repeated record or has to be started anew.
+class OptimisationJournal {
+    fs::path journal_path;
+    uint64_t pattern_hash;
+    std::ofstream file;
+    /// Records read from the journal when it was opened, until they are taken.
+    std::vector<std::vector<CachedEvaluation>> records;
+    /// Generating parameters of all records in the journal, so that repeated samples are not appended.
+    std::unordered_set<uint64_t> parameters_keys;
+
+    /// Reads the records of the journal. Returns whether the journal can be appended to as it is.
+    bool readJournal();
+
+    /// Rewrites the journal with the records read from it and reopens it for appending.
+    void compact();
+
+public:
+    /// Opens the journal of the pattern. If it is not resumed, or it belongs to a different version of the pattern, it
+    /// is started anew.
+    OptimisationJournal(fs::path journal_path, uint64_t pattern_hash, bool is_resumed);
+
+    /// Appends the record of the generating parameters, unless they are already in the journal
+    void append(const FillingConfig &config, const std::vector<FillMetrics> &seed_metrics);
+
+    /// Evaluations of all seeds of the records read when the journal was opened. They are released from the journal.
+    [[nodiscard]] std::vector<CachedEvaluation> takeEvaluations();
+
+    /// Reads the evaluations of the journal of any pattern without modifying it. Returns no evaluations if the journal
+    /// does not exist or has incompatible format.
+    static std::vector<CachedEvaluation> readEvaluations(const fs::path &journal_path);
+};
+
+
+#endif //VECTOR_SLICER_OPTIMISATION_JOURNAL_H
@@ -0,0 +1,42 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 18/10/2026.
+//
+
+#include "hashing.h"
+
+void StableHash::add(const void *data, size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+        state ^= bytes[i];
+        state *= 1099511628211ULL;
+    }
+}
+
+void StableHash::add(const std::string &text) {
+    add(text.size());
+    add(text.data(), text.size());
+}
+
+uint64_t StableHash::getHash() const {
+    return state;
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 18/10/2026.
+//
+
+#ifndef VECTOR_SLICER_HASHING_H
+#define VECTOR_SLICER_HASHING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+/// \brief Incremental 64-bit FNV-1a hash. Unlike std::hash it is stable between compilers and runs, so it can be used
+/// for keys that are stored on disk.
+class StableHash {
+    uint64_t state = 14695981039346656037ULL;
+
+public:
+    void add(const void *data, size_t size);
+
+    void add(const std::string &text);
+
+    template<typename T>
+    void add(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be hashed directly.");
+        add(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void add(const std::vector<T> &values) {
+        add(values.size());
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            add(values.data(), values.size() * sizeof(T));
+        } else {
+            for (const T &value: values) {
+                add(value);
+            }
+        }
+    }
+
+    [[nodiscard]] uint64_t getHash() const;
+};
+
+
+#endif //VECTOR_SLICER_HASHING_H
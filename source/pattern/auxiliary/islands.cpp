@@ -0,0 +1,122 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 19/10/2026.
+//
+
+#include "islands.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+void labelIsland(const std::vector<std::vector<uint8_t>> &shape_matrix, const coord &start, uint16_t label,
+                 IslandMap &island_map) {
+    int rows = (int) shape_matrix.size();
+    int columns = (int) shape_matrix[0].size();
+    Island island = {start, start};
+    std::vector<coord> stack = {start};
+    island_map.labels.getReference(start) = label;
+    while (!stack.empty()) {
+        coord current = stack.back();
+        stack.pop_back();
+        island.minimum = {std::min(island.minimum.x, current.x), std::min(island.minimum.y, current.y)};
+        island.maximum = {std::max(island.maximum.x, current.x), std::max(island.maximum.y, current.y)};
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                int x = current.x + dx;
+                int y = current.y + dy;
+                if (x < 0 || x >= rows || y < 0 || y >= columns || !shape_matrix[x][y] ||
+                    island_map.labels.get(x, y) != 0) {
+                    continue;
+                }
+                island_map.labels.getReference(x, y) = label;
+                stack.emplace_back(x, y);
+            }
+        }
+    }
+    island_map.islands.push_back(island);
+}
+
+IslandMap findIslands(const std::vector<std::vector<uint8_t>> &shape_matrix) {
+    if (shape_matrix.empty() || shape_matrix[0].empty()) {
+        return {};
+    }
+    int rows = (int) shape_matrix.size();
+    int columns = (int) shape_matrix[0].size();
+    IslandMap island_map = {TiledGrid<uint16_t>(rows, columns), {}};
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < columns; y++) {
+            if (!shape_matrix[x][y] || island_map.labels.get(x, y) != 0) {
+                continue;
+            }
+            if (island_map.islands.size() == std::numeric_limits<uint16_t>::max()) {
+                return {TiledGrid<uint16_t>(), {{{0, 0}, coord(rows - 1, columns - 1)}}};
+            }
+            labelIsland(shape_matrix, {x, y}, (uint16_t) (island_map.islands.size() + 1), island_map);
+        }
+    }
+    return island_map;
+}
+
+int findRoot(std::vector<int> &parents, int island) {
+    while (parents[island] != island) {
+        parents[island] = parents[parents[island]];
+        island = parents[island];
+    }
+    return island;
+}
+
+bool areClose(const Island &first, const Island &second, int separation) {
+    return first.minimum.x <= second.maximum.x + separation && second.minimum.x <= first.maximum.x + separation &&
+           first.minimum.y <= second.maximum.y + separation && second.minimum.y <= first.maximum.y + separation;
+}
+
+std::vector<int> groupIslands(const std::vector<Island> &islands, int separation) {
+    std::vector<int> parents(islands.size());
+    std::iota(parents.begin(), parents.end(), 0);
+
+    std::vector<int> order(islands.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&islands](int first, int second) {
+        return islands[first].minimum.x < islands[second].minimum.x;
+    });
+    for (int i = 0; i < order.size(); i++) {
+        const Island &island = islands[order[i]];
+        for (int j = i + 1; j < order.size() && islands[order[j]].minimum.x <= island.maximum.x + separation; j++) {
+            if (areClose(island, islands[order[j]], separation)) {
+                parents[findRoot(parents, order[i])] = findRoot(parents, order[j]);
+            }
+        }
+    }
+
+    std::vector<int> root_groups(islands.size(), -1);
+    std::vector<int> groups(islands.size());
+    int group_count = 0;
+    for (int i = 0; i < islands.size(); i++) {
+        int root = findRoot(parents, i);
+        if (root_groups[root] == -1) {
+            root_groups[root] = group_count++;
+        }
+        groups[i] = root_groups[root];
+    }
+    return groups;
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 19/10/2026.
+//
+
+#ifndef VECTOR_SLICER_ISLANDS_H
+#define VECTOR_SLICER_ISLANDS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../coord.h"
+#include "../tiled_grid.h"
+
+/// Bounding box of a connected part of the shape
+struct Island {
+    coord minimum;
+    coord maximum;
+};
+
+/// Connected parts of the shape. Points outside of the shape have label 0 and points of island i have label i + 1.
+struct IslandMap {
+    TiledGrid<uint16_t> labels;
+    std::vector<Island> islands;
+};
+
+/// Labels the 8-connected parts of the shape. If there are more of them than the labels can hold, the whole shape is
+/// treated as a single island without labels.
+IslandMap findIslands(const std::vector<std::vector<uint8_t>> &shape_matrix);
+
+/// Groups together the islands whose bounding boxes are closer than the separation, so that islands of different groups
+/// are at least the separation apart. Returns the group of each island, numbered in the order of their first islands.
+std::vector<int> groupIslands(const std::vector<Island> &islands, int separation);
+
+#endif //VECTOR_SLICER_ISLANDS_H
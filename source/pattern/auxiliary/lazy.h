@@ -0,0 +1,109 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 19/10/2026.
+//
+
+#ifndef VECTOR_SLICER_LAZY_H
+#define VECTOR_SLICER_LAZY_H
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+/// \brief Value calculated on its first use. Initialisation is thread-safe: if several threads request the value at
+/// once, only one of them calculates it and the others wait for the result. Copies share nothing but the value.
+template<typename T>
+class Lazy {
+    mutable std::mutex mutex;
+    mutable std::atomic<bool> is_initialised{false};
+    mutable T value;
+
+public:
+    Lazy() = default;
+
+    Lazy(const Lazy &other) {
+        std::lock_guard<std::mutex> lock(other.mutex);
+        value = other.value;
+        is_initialised.store(other.is_initialised.load());
+    }
+
+    Lazy(Lazy &&other) noexcept {
+        std::lock_guard<std::mutex> lock(other.mutex);
+        value = std::move(other.value);
+        is_initialised.store(other.is_initialised.load());
+    }
+
+    Lazy &operator=(const Lazy &other) {
+        if (this != &other) {
+            std::scoped_lock lock(mutex, other.mutex);
+            value = other.value;
+            is_initialised.store(other.is_initialised.load());
+        }
+        return *this;
+    }
+
+    Lazy &operator=(Lazy &&other) noexcept {
+        if (this != &other) {
+            std::scoped_lock lock(mutex, other.mutex);
+            value = std::move(other.value);
+            is_initialised.store(other.is_initialised.load());
+        }
+        return *this;
+    }
+
+    /// Returns the value, calculating it with initialise() if it is requested for the first time
+    template<typename Initialiser>
+    const T &get(Initialiser &&initialise) const {
+        if (!is_initialised.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!is_initialised.load(std::memory_order_relaxed)) {
+                value = initialise();
+                is_initialised.store(true, std::memory_order_release);
+            }
+        }
+        return value;
+    }
+
+    /// Returns the value if it was already calculated, otherwise nullptr
+    const T *peek() const {
+        return is_initialised.load(std::memory_order_acquire) ? &value : nullptr;
+    }
+
+    void set(T new_value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        value = std::move(new_value);
+        is_initialised.store(true, std::memory_order_release);
+    }
+
+    /// Releases the value, which is calculated again on its next use. Not thread-safe with respect to get().
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        value = T();
+        is_initialised.store(false, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool isInitialised() const {
+        return is_initialised.load(std::memory_order_acquire);
+    }
+};
+
+#endif //VECTOR_SLICER_LAZY_H
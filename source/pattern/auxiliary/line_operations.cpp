@@ -30,20 +30,21 @@
 #include "valarray_operations.h"
 
 
-coord findClosestNeighbour(coord_set &array, coord &element) {
-    coord closest_element = *array.begin();
-
-    std::vector<coord> displacements = {{1,  0},
-                                        {0,  1},
-                                        {-1, 0},
-                                        {0,  -1},
-                                        {1,  1},
-                                        {-1, 1},
-                                        {-1, -1},
-                                        {1,  -1}};
+template<typename Set>
+coord findClosestNeighbour(Set &array, coord &element) {
+    coord closest_element = array.front();
+
+    static const std::vector<coord> displacements = {{1,  0},
+                                                     {0,  1},
+                                                     {-1, 0},
+                                                     {0,  -1},
+                                                     {1,  1},
+                                                     {-1, 1},
+                                                     {-1, -1},
+                                                     {1,  -1}};
 
     for (const coord &displacement: displacements) {
-        if (array.find(element + displacement) != array.end()) {
+        if (array.contains(element + displacement)) {
             closest_element = element + displacement;
             break;
         }
@@ -59,8 +60,9 @@ bool isLooped(const std::vector<coord> &line) {
     return norm(first - last) <= 2;
 }
 
+template<typename Set>
 std::vector<std::vector<coord>>
-separateIntoLines(coord_set &unsorted_perimeters, coord starting_coordinates, double separation_distance) {
+separateIntoLinesOfSet(Set &unsorted_perimeters, coord starting_coordinates, double separation_distance) {
     coord current_element = findClosestNeighbour(unsorted_perimeters, starting_coordinates);
     std::vector<std::vector<coord>> forwards_paths;
     std::vector<std::vector<coord>> backwards_paths;
@@ -103,6 +105,16 @@ separateIntoLines(coord_set &unsorted_perimeters, coord starting_coordinates, do
     return separated_paths;
 }
 
+std::vector<std::vector<coord>>
+separateIntoLines(coord_set &unsorted_perimeters, coord starting_coordinates, double separation_distance) {
+    return separateIntoLinesOfSet(unsorted_perimeters, starting_coordinates, separation_distance);
+}
+
+std::vector<std::vector<coord>>
+separateIntoLines(DenseCoordSet &unsorted_perimeters, coord starting_coordinates, double separation_distance) {
+    return separateIntoLinesOfSet(unsorted_perimeters, starting_coordinates, separation_distance);
+}
+
 
 /// Creates pixel representation of a line - Bresenham's line algorithm. Works only when dx >= dy and dx > 0.
 std::vector<coord> pixeliseLineBase(const coord_d &line) {
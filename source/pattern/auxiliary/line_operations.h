@@ -28,6 +28,7 @@
 #include <vector>
 #include <tuple>
 #include "../coord.h"
+#include "../coord_set.h"
 
 using vecd = std::vector<double>;
 using veci = std::vector<int>;
@@ -37,6 +38,9 @@ std::vector<std::vector<veci>> separateLines(std::vector<veci> &sorted_perimeter
 std::vector<std::vector<coord>>
 separateIntoLines(coord_set &unsorted_perimeters, coord starting_coordinates, double separation_distance);
 
+std::vector<std::vector<coord>>
+separateIntoLines(DenseCoordSet &unsorted_perimeters, coord starting_coordinates, double separation_distance);
+
 bool isLooped(const std::vector<coord> &line);
 
 std::vector<coord> pixeliseLine(const coord_d &line);
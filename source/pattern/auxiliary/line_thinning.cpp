@@ -28,23 +28,30 @@
 #include <omp.h>
 #include <fstream>
 #include <unordered_set>
+#include <array>
+#include <algorithm>
 
 #include "geometry.h"
 #include "vector_operations.h"
 
 
+/// Neighbours of the pixel are encoded as bits 0-7 of the neighbour code in the order P2-P9 of
+/// https://rosettacode.org/wiki/Zhang-Suen_thinning_algorithm
+bool isNeighbourFilled(uint8_t neighbour_code, int neighbour) {
+    return (neighbour_code >> (neighbour - 2)) & 1;
+}
+
 /// Based on https://rosettacode.org/wiki/Zhang-Suen_thinning_algorithm Step 1
-bool isRemovedEastSouth(const coord_set &shape, const coord &coordinate) {
+bool isRemovedEastSouth(uint8_t neighbour_code) {
     /// true -> black, false -> white
-    bool P1 = shape.find(coordinate) != shape.end();
-    bool P2 = shape.find(coordinate + coord{1, 0}) != shape.end();
-    bool P3 = shape.find(coordinate + coord{1, 1}) != shape.end();
-    bool P4 = shape.find(coordinate + coord{0, 1}) != shape.end();
-    bool P5 = shape.find(coordinate + coord{-1, 1}) != shape.end();
-    bool P6 = shape.find(coordinate + coord{-1, 0}) != shape.end();
-    bool P7 = shape.find(coordinate + coord{-1, -1}) != shape.end();
-    bool P8 = shape.find(coordinate + coord{0, -1}) != shape.end();
-    bool P9 = shape.find(coordinate + coord{1, -1}) != shape.end();
+    bool P2 = isNeighbourFilled(neighbour_code, 2);
+    bool P3 = isNeighbourFilled(neighbour_code, 3);
+    bool P4 = isNeighbourFilled(neighbour_code, 4);
+    bool P5 = isNeighbourFilled(neighbour_code, 5);
+    bool P6 = isNeighbourFilled(neighbour_code, 6);
+    bool P7 = isNeighbourFilled(neighbour_code, 7);
+    bool P8 = isNeighbourFilled(neighbour_code, 8);
+    bool P9 = isNeighbourFilled(neighbour_code, 9);
 
     int filled_neighbours = P2 + P3 + P4 + P5 + P6 + P7 + P8 + P9;
     int number_of_colour_transitions = (!P2 && P3) +
@@ -59,24 +66,22 @@ bool isRemovedEastSouth(const coord_set &shape, const coord &coordinate) {
     bool first_condition = !P2 || !P4 || !P6;
     bool second_condition = !P4 || !P6 || !P8;
 
-    return (P1 &&
-            2 <= filled_neighbours && filled_neighbours <= 6 &&
+    return (2 <= filled_neighbours && filled_neighbours <= 6 &&
             number_of_colour_transitions == 1 &&
             first_condition &&
             second_condition);
 }
 
-/// Based on https://rosettacode.org/wiki/Zhang-Suen_thinning_algorithm Step 1
-bool isRemovedNorthWest(const coord_set &shape, const coord &coordinate) {
-    bool P1 = shape.find(coordinate) != shape.end();
-    bool P2 = shape.find(coordinate + coord{1, 0}) != shape.end();
-    bool P3 = shape.find(coordinate + coord{1, 1}) != shape.end();
-    bool P4 = shape.find(coordinate + coord{0, 1}) != shape.end();
-    bool P5 = shape.find(coordinate + coord{-1, 1}) != shape.end();
-    bool P6 = shape.find(coordinate + coord{-1, 0}) != shape.end();
-    bool P7 = shape.find(coordinate + coord{-1, -1}) != shape.end();
-    bool P8 = shape.find(coordinate + coord{0, -1}) != shape.end();
-    bool P9 = shape.find(coordinate + coord{1, -1}) != shape.end();
+/// Based on https://rosettacode.org/wiki/Zhang-Suen_thinning_algorithm Step 2
+bool isRemovedNorthWest(uint8_t neighbour_code) {
+    bool P2 = isNeighbourFilled(neighbour_code, 2);
+    bool P3 = isNeighbourFilled(neighbour_code, 3);
+    bool P4 = isNeighbourFilled(neighbour_code, 4);
+    bool P5 = isNeighbourFilled(neighbour_code, 5);
+    bool P6 = isNeighbourFilled(neighbour_code, 6);
+    bool P7 = isNeighbourFilled(neighbour_code, 7);
+    bool P8 = isNeighbourFilled(neighbour_code, 8);
+    bool P9 = isNeighbourFilled(neighbour_code, 9);
 
     int filled_neighbours = P2 + P3 + P4 + P5 + P6 + P7 + P8 + P9;
     int number_of_colour_transitions = (!P2 && P3) +
@@ -91,13 +96,67 @@ bool isRemovedNorthWest(const coord_set &shape, const coord &coordinate) {
     bool first_condition = !P2 || !P4 || !P8;
     bool second_condition = !P2 || !P6 || !P8;
 
-    return (P1 &&
-            2 <= filled_neighbours && filled_neighbours <= 6 &&
+    return (2 <= filled_neighbours && filled_neighbours <= 6 &&
             number_of_colour_transitions == 1 &&
             first_condition &&
             second_condition);
 }
 
+/// Whether a filled pixel is removed, for each of the neighbour codes
+std::array<bool, 256> removalTable(bool (*is_removed)(uint8_t)) {
+    std::array<bool, 256> table{};
+    for (int neighbour_code = 0; neighbour_code < 256; neighbour_code++) {
+        table[neighbour_code] = is_removed((uint8_t) neighbour_code);
+    }
+    return table;
+}
+
+
+/// Dense bitmap of the bounding box of a pattern with a margin of one pixel, so that every filled pixel has all its
+/// neighbours within the tile.
+class BinaryTile {
+    coord origin;
+    int rows;
+    int row_length;
+    std::vector<uint8_t> pixels;
+
+public:
+    BinaryTile(const coord &minimum, const coord &maximum) :
+            origin(minimum - coord{1, 1}),
+            rows(maximum.x - minimum.x + 3),
+            row_length(maximum.y - minimum.y + 3),
+            pixels(rows * row_length, 0) {}
+
+    uint8_t &operator[](const coord &coordinate) {
+        return pixels[(coordinate.x - origin.x) * row_length + coordinate.y - origin.y];
+    }
+
+    /// Neighbours P2-P9 of the pixel with given index as bits 0-7
+    uint8_t neighbourCode(int index) const {
+        return pixels[index + row_length] |
+               pixels[index + row_length + 1] << 1 |
+               pixels[index + 1] << 2 |
+               pixels[index - row_length + 1] << 3 |
+               pixels[index - row_length] << 4 |
+               pixels[index - row_length - 1] << 5 |
+               pixels[index - 1] << 6 |
+               pixels[index + row_length - 1] << 7;
+    }
+
+    /// Removes, at the same time, all filled pixels whose neighbour code is marked in the removal table
+    void thin(const std::array<bool, 256> &removal_table, std::vector<int> &removed_pixels) {
+        removed_pixels.clear();
+        for (int i = 1; i < rows - 1; i++) {
+            for (int index = i * row_length + 1; index < (i + 1) * row_length - 1; index++) {
+                if (pixels[index] && removal_table[neighbourCode(index)]) {
+                    removed_pixels.push_back(index);
+                }
+            }
+        }
+        for (int index: removed_pixels) { pixels[index] = 0; }
+    }
+};
+
 
 bool isSurroundedByFilledElements(const std::set<veci> &shape, const veci &coordinate) {
     bool is_this_filled = shape.find(coordinate) != shape.end();
@@ -128,26 +187,44 @@ coord_set grow_pattern(const coord_set &shape, double radius, const std::vector<
 
 
 coord_set skeletonize(coord_set shape, int grow_size, const std::vector<std::vector<uint8_t>> &shape_matrix) {
-    shape = grow_pattern(shape, grow_size, shape_matrix);
-    /// Instead of doing the skeletonisation until convergence, we only aim to reduce what was added by the growth.
-    for (int i = 0; i <= grow_size * 2; i++) {
-        coord_set coordinates_to_remove_stage_one;
-        for (auto &coordinate: shape) {
-            if (isRemovedEastSouth(shape, coordinate)) {
-                coordinates_to_remove_stage_one.insert(coordinate);
-            }
-        }
-
-        for (auto &coordinate: coordinates_to_remove_stage_one) { shape.erase(coordinate); }
+    if (shape.empty()) {
+        return shape;
+    }
+    std::vector<coord> circle = findPointsInDisk(grow_size);
+    coord minimum = *shape.begin();
+    coord maximum = *shape.begin();
+    for (auto &element: shape) {
+        minimum = {std::min(minimum.x, element.x), std::min(minimum.y, element.y)};
+        maximum = {std::max(maximum.x, element.x), std::max(maximum.y, element.y)};
+    }
+    BinaryTile tile(minimum - coord{grow_size, grow_size}, maximum + coord{grow_size, grow_size});
 
-        coord_set coordinates_to_remove_stage_two;
-        for (auto &coordinate: shape) {
-            if (isRemovedNorthWest(shape, coordinate)) {
-                coordinates_to_remove_stage_two.insert(coordinate);
+    // Same as grow_pattern, but each coordinate is inserted only once, which leaves the set in the same state.
+    coord_set grown_pattern;
+    std::vector<coord> grown_coordinates;
+    for (auto &element: shape) {
+        for (auto &displacement: circle) {
+            coord current = element + displacement;
+            if (shape_matrix[current.x][current.y] && !tile[current]) {
+                tile[current] = 1;
+                grown_coordinates.emplace_back(current);
+                grown_pattern.insert(current);
             }
         }
+    }
 
-        for (auto &coordinate: coordinates_to_remove_stage_two) { shape.erase(coordinate); }
+    static const std::array<bool, 256> removal_table_stage_one = removalTable(isRemovedEastSouth);
+    static const std::array<bool, 256> removal_table_stage_two = removalTable(isRemovedNorthWest);
+    std::vector<int> removed_pixels;
+    /// Instead of doing the skeletonisation until convergence, we only aim to reduce what was added by the growth.
+    for (int i = 0; i <= grow_size * 2; i++) {
+        tile.thin(removal_table_stage_one, removed_pixels);
+        tile.thin(removal_table_stage_two, removed_pixels);
+    }
+
+    // Removed coordinates are erased from the grown set, so that the skeleton is iterated in the same order as before.
+    for (auto &coordinate: grown_coordinates) {
+        if (!tile[coordinate]) { grown_pattern.erase(coordinate); }
     }
-    return shape;
+    return grown_pattern;
 }
@@ -30,6 +30,7 @@
 #include <unordered_set>
 #include <boost/functional/hash.hpp>
 #include "../coord.h"
+#include "../coord_set.h"
 
 /// Zhang-Suen line thinning algorithm
 coord_set skeletonize(coord_set shape, int grow_size, const std::vector<std::vector<uint8_t>> &shape_matrix);
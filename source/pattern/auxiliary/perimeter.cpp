@@ -77,14 +77,14 @@ isPerimeterFree(const std::vector<std::vector<uint8_t>> &filled_table, const std
 
 
 bool isOnEdge(const std::vector<std::vector<uint8_t>> &shape_table, const coord &coordinates, const veci &sizes) {
-    std::vector<coord> neighbour_displacements_list = {{-1, 0},
-                                                      {-1, 1},
-                                                      {0,  1},
-                                                      {1,  1},
-                                                      {1,  0},
-                                                      {1,  -1},
-                                                      {0,  -1},
-                                                      {-1, -1}};
+    static const std::vector<coord> neighbour_displacements_list = {{-1, 0},
+                                                                   {-1, 1},
+                                                                   {0,  1},
+                                                                   {1,  1},
+                                                                   {1,  0},
+                                                                   {1,  -1},
+                                                                   {0,  -1},
+                                                                   {-1, -1}};
 
     if (isEmpty(coordinates, shape_table)) {
         return false;
@@ -124,12 +124,9 @@ getOutwardPointingVector(const coord &current_position, const std::vector<std::v
 }
 
 
+/// Whether the splay at the point of the edge points outwards of the shape
 bool isValidPerimeterPoint(const coord &positions, const std::vector<std::vector<uint8_t>> &shape_matrix, const veci &sizes,
                            const std::vector<coord> &tested_circle, const std::vector<std::vector<coord_d>> &splay_array) {
-    if (!isOnEdge(shape_matrix, positions, sizes)) {
-        return false;
-    }
-
     coord_d outward_pointing_vector = normalized(getOutwardPointingVector(positions, shape_matrix, sizes, tested_circle));
     coord_d current_splay = splay_array[positions.x][positions.y];
 
@@ -138,47 +135,58 @@ bool isValidPerimeterPoint(const coord &positions, const std::vector<std::vector
     return dot(outward_pointing_vector, current_splay) > zero_splay_threshold;
 }
 
-coord_set findValidPerimeterPoints(const std::vector<std::vector<uint8_t>> &shape_matrix, const veci &sizes,
-                                   const std::vector<std::vector<coord_d>> &splay_array) {
-    coord_set unsorted_perimeters;
-    std::vector<coord> tested_circle = circleDisplacements(4);
+/// Points of the shape neighbouring a point outside of it, in row-major order
+std::vector<coord> findEdgePoints(const std::vector<std::vector<uint8_t>> &shape_matrix, const veci &sizes) {
+    std::vector<coord> edge_points;
     for (int i = 0; i < sizes[0]; i++) {
         for (int j = 0; j < sizes[1]; j++) {
-            coord current_position = {i, j};
-            if (isValidPerimeterPoint({i, j}, shape_matrix, sizes, tested_circle, splay_array)) {
-                unsorted_perimeters.insert(current_position);
+            if (isOnEdge(shape_matrix, {i, j}, sizes)) {
+                edge_points.emplace_back(i, j);
             }
         }
     }
-    return unsorted_perimeters;
+    return edge_points;
 }
 
-coord_set findGeometricalPerimeter(const std::vector<std::vector<uint8_t>> &shape_matrix, const veci &sizes) {
-    coord_set unsorted_perimeters;
-    // It is set to constant radius, maybe add a control over it?
+DenseCoordSet findValidPerimeterPoints(const std::vector<coord> &edge_points,
+                                       const std::vector<std::vector<uint8_t>> &shape_matrix, const veci &sizes,
+                                       const std::vector<std::vector<coord_d>> &splay_array) {
+    DenseCoordSet unsorted_perimeters(sizes[0], sizes[1]);
     std::vector<coord> tested_circle = circleDisplacements(4);
-    for (int i = 0; i < sizes[0]; i++) {
-        for (int j = 0; j < sizes[1]; j++) {
-            coord current_position = {i, j};
-            if (isOnEdge(shape_matrix, {i, j}, sizes)) {
-                unsorted_perimeters.insert(current_position);
-            }
+    for (auto &edge_point: edge_points) {
+        if (isValidPerimeterPoint(edge_point, shape_matrix, sizes, tested_circle, splay_array)) {
+            unsorted_perimeters.insert(edge_point);
         }
     }
     return unsorted_perimeters;
 }
 
+DenseCoordSet findGeometricalPerimeter(const std::vector<coord> &edge_points, const veci &sizes) {
+    DenseCoordSet unsorted_perimeters(sizes[0], sizes[1]);
+    for (auto &edge_point: edge_points) {
+        unsorted_perimeters.insert(edge_point);
+    }
+    return unsorted_perimeters;
+}
+
 
 std::vector<std::vector<coord>>
 findSeparatedPerimeters(const std::vector<std::vector<uint8_t>> &shape_matrix, const veci &sizes,
                         const std::vector<std::vector<coord_d>> &splay_array) {
-    coord_set unsorted_perimeters = findValidPerimeterPoints(shape_matrix, sizes, splay_array);
-    std::vector<std::vector<coord>> separated_perimeters = separateIntoLines(unsorted_perimeters, {0, 0}, 2);
+    std::vector<coord> edge_points = findEdgePoints(shape_matrix, sizes);
+    if (edge_points.empty()) {
+        return {};
+    }
+    DenseCoordSet unsorted_perimeters = findValidPerimeterPoints(edge_points, shape_matrix, sizes, splay_array);
+    std::vector<std::vector<coord>> separated_perimeters;
+    if (!unsorted_perimeters.empty()) {
+        separated_perimeters = separateIntoLines(unsorted_perimeters, {0, 0}, 2);
+    }
     // If using the splay approach for selecting splay-valid perimeter points yields single points that are unconnected
     // then separation into perimeters will not detect any lines. Therefore, we revert to the simple geometrical
     // definition of perimeter, where point within the pattern that neighbours one that is outside is counted as perimeter.
     if (separated_perimeters.empty()) {
-        unsorted_perimeters = findGeometricalPerimeter(shape_matrix, sizes);
+        unsorted_perimeters = findGeometricalPerimeter(edge_points, sizes);
         separated_perimeters = separateIntoLines(unsorted_perimeters, {0, 0}, 2);
     }
     return separated_perimeters;
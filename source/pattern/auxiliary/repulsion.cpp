@@ -49,7 +49,7 @@ coord_d
 getRepulsionFromDisplacement(const coord_d &coordinates, const std::vector<coord> &current_displacements,
                              const veci &sizes,
                              const std::vector<std::vector<uint8_t>> &shape_matrix,
-                             const std::vector<std::vector<uint8_t>> &filled_table) {
+                             const TiledGrid<uint8_t> &filled_table) {
     int number_of_repulsing_coordinates = 0;
     coord empty_spot_attraction = {0, 0};
     auto i_coords = coord(coordinates);
@@ -57,7 +57,7 @@ getRepulsionFromDisplacement(const coord_d &coordinates, const std::vector<coord
         coord neighbour = i_coords + displacement;
         if (isInRange(neighbour, sizes) &&
             !isEmpty(neighbour, shape_matrix) &&
-            isEmpty(neighbour, filled_table)) {
+            filled_table.get(neighbour) == 0) {
 
             empty_spot_attraction = empty_spot_attraction + displacement;
             number_of_repulsing_coordinates++;
@@ -71,7 +71,7 @@ getRepulsionFromDisplacement(const coord_d &coordinates, const std::vector<coord
 
 
 coord_d getLineBasedRepulsion(const std::vector<std::vector<uint8_t>> &shape_matrix,
-                              const std::vector<std::vector<uint8_t>> &filled_table, const coord_d &tangent,
+                              const TiledGrid<uint8_t> &filled_table, const coord_d &tangent,
                               const coord_d &coordinates, const veci &sizes, double radius,
                               double repulsion_coefficient, double minimum_projection) {
     std::vector<coord> normal_displacements = generateLineDisplacements(tangent, radius - 1);
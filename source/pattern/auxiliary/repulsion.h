@@ -28,13 +28,14 @@
 #include <vector>
 #include <tuple>
 #include "geometry.h"
+#include "../tiled_grid.h"
 
 using vecd = std::vector<double>;
 using veci = std::vector<int>;
 
 coord_d
 getLineBasedRepulsion(const std::vector<std::vector<uint8_t>> &shape_matrix,
-                      const std::vector<std::vector<uint8_t>> &filled_table, const coord_d &tangent,
+                      const TiledGrid<uint8_t> &filled_table, const coord_d &tangent,
                       const coord_d &coordinates, const veci &sizes, double radius,
                       double repulsion_coefficient, double minimum_projection);
 
@@ -46,35 +46,74 @@ double decimalPart(double number) {
     return number - floor(number);
 }
 
-std::vector<std::vector<coord_d>>
-joinTables(const std::vector<std::vector<double>> &x_field, const std::vector<std::vector<double>> &y_field,
-           int threads) {
-    assert((x_field.size() == y_field.size()));
-    std::vector<std::vector<coord_d>> joined_table(x_field.size(), std::vector<coord_d>(x_field[0].size()));
-
-    omp_set_num_threads(threads);
-#pragma omp parallel for
-    for (int i = 0; i < x_field.size(); i++) {
-        assert((x_field[i].size() == y_field[i].size()));
-        for (int j = 0; j < x_field[i].size(); j++) {
-            joined_table[i][j] = {x_field[i][j], y_field[i][j]};
+/// Q = n (tensor) n of a row of the normalised director field, stored as separate columns of its components. Q is
+/// symmetric, so xy is used for both off-diagonal elements.
+struct QTensorRow {
+    std::vector<double> xx;
+    std::vector<double> xy;
+    std::vector<double> yy;
+
+    explicit QTensorRow(size_t size) : xx(size), xy(size), yy(size) {}
+
+    void update(const std::vector<double> &x_row, const std::vector<double> &y_row) {
+        const double *x = x_row.data();
+        const double *y = y_row.data();
+        double *q_xx = xx.data();
+        double *q_xy = xy.data();
+        double *q_yy = yy.data();
+        int size = (int) xx.size();
+#pragma omp simd
+        for (int j = 0; j < size; j++) {
+            // Same as coord_d::normalized
+            double norm = sqrt(x[j] * x[j] + y[j] * y[j]);
+            norm = norm != 0 ? norm : 1e-6;
+            double n_x = x[j] / norm;
+            double n_y = y[j] / norm;
+            q_xx[j] = n_x * n_x;
+            q_xy[j] = n_x * n_y;
+            q_yy[j] = n_y * n_y;
         }
     }
-    return joined_table;
-}
-
-std::vector<std::vector<matrix_d>>
-tensorWithItself(const std::vector<std::vector<coord_d>> &director, int threads) {
-    std::vector<std::vector<matrix_d>> result(director.size(), std::vector<matrix_d>(director[0].size()));
-
-    omp_set_num_threads(threads);
-#pragma omp parallel for
-    for (int i = 0; i < director.size(); i++) {
-        for (int j = 0; j < director[i].size(); j++) {
-            result[i][j] = tensor(director[i][j], director[i][j]);
-        }
+};
+
+
+/// Calculates the splay of a row from the Q-tensors of it and of the neighbouring rows. The products are written out
+/// as in matrix_multiply and summed in the same order, so that the splay does not depend on the vectorisation.
+void splayRow(const QTensorRow &previous, const QTensorRow &current, const QTensorRow &next,
+              std::vector<coord_d> &splay_row) {
+    int size = (int) current.xx.size();
+    const double *p_xx = previous.xx.data(), *p_xy = previous.xy.data(), *p_yy = previous.yy.data();
+    const double *c_xx = current.xx.data(), *c_xy = current.xy.data(), *c_yy = current.yy.data();
+    const double *n_xx = next.xx.data(), *n_xy = next.xy.data(), *n_yy = next.yy.data();
+    coord_d *splay = splay_row.data();
+#pragma omp simd
+    for (int j = 1; j < size - 1; j++) {
+        double divergence_x = 1 * n_xx[j] + 0 * n_xy[j];
+        double divergence_y = 1 * n_xy[j] + 0 * n_yy[j];
+        divergence_x += 0 * c_xx[j + 1] + 1 * c_xy[j + 1];
+        divergence_y += 0 * c_xy[j + 1] + 1 * c_yy[j + 1];
+        divergence_x += -1 * p_xx[j] + 0 * p_xy[j];
+        divergence_y += -1 * p_xy[j] + 0 * p_yy[j];
+        divergence_x += 0 * c_xx[j - 1] + -1 * c_xy[j - 1];
+        divergence_y += 0 * c_xy[j - 1] + -1 * c_yy[j - 1];
+
+        divergence_x += 0.5 * n_xx[j + 1] + 0.5 * n_xy[j + 1];
+        divergence_y += 0.5 * n_xy[j + 1] + 0.5 * n_yy[j + 1];
+        divergence_x += -0.5 * p_xx[j + 1] + 0.5 * p_xy[j + 1];
+        divergence_y += -0.5 * p_xy[j + 1] + 0.5 * p_yy[j + 1];
+        divergence_x += 0.5 * n_xx[j - 1] + -0.5 * n_xy[j - 1];
+        divergence_y += 0.5 * n_xy[j - 1] + -0.5 * n_yy[j - 1];
+        divergence_x += -0.5 * p_xx[j - 1] + -0.5 * p_xy[j - 1];
+        divergence_y += -0.5 * p_xy[j - 1] + -0.5 * p_yy[j - 1];
+
+        double splay_x = divergence_x * c_xx[j] + divergence_y * c_xy[j];
+        double splay_y = divergence_x * c_xy[j] + divergence_y * c_yy[j];
+        splay[j].x = splay_x;
+        splay[j].y = splay_y;
     }
-    return result;
+    // Use splay vector values from edge adjacent elements
+    splay[0] = splay[1];
+    splay[size - 1] = splay[size - 2];
 }
 
 
@@ -82,47 +121,37 @@ tensorWithItself(const std::vector<std::vector<coord_d>> &director, int threads)
 std::vector<std::vector<coord_d>>
 splayVector(const std::vector<std::vector<double>> &x_field, const std::vector<std::vector<double>> &y_field,
             int threads) {
-    std::vector<std::vector<coord_d>> director = normalizeVectorArray(joinTables(x_field, y_field, threads), threads);
-    std::vector<std::vector<matrix_d>> q_tensor = tensorWithItself(director, threads);
-
-    std::vector<std::vector<coord_d>> splay_table(x_field.size(), std::vector<coord_d>(x_field[0].size()));
-    // Temporarily use 0 splay values
-    splay_table.front() = {x_field[0].size(), coord_d{0, 0}};
-    splay_table.back() = {x_field[0].size(), coord_d{0, 0}};
+    assert((x_field.size() == y_field.size()));
+    size_t x_size = x_field.size();
+    size_t y_size = x_field[0].size();
+    std::vector<std::vector<coord_d>> splay_table(x_size, std::vector<coord_d>(y_size));
 
+    int interior_rows = (int) x_size - 2;
     omp_set_num_threads(threads);
-#pragma omp parallel for
-    for (int i = 1; i < director.size() - 1; i++) {
-        // Temporarily use 0 splay values
-        splay_table[i].front() = {0, 0};
-        splay_table[i].back() = {0, 0};
-        for (int j = 1; j < director[i].size() - 1; j++) {
-            coord_d q_divergence;
-            q_divergence = matrix_multiply(q_tensor[i + 1][j], {1, 0});
-            q_divergence +=  matrix_multiply(q_tensor[i][j + 1], {0, 1});
-            q_divergence += matrix_multiply(q_tensor[i - 1][j], {-1, 0});
-            q_divergence += matrix_multiply(q_tensor[i][j - 1], {0, -1});
-
-            q_divergence += matrix_multiply(q_tensor[i + 1][j + 1], {0.5, 0.5});
-            q_divergence += matrix_multiply(q_tensor[i - 1][j + 1], {-0.5, 0.5});
-            q_divergence += matrix_multiply(q_tensor[i + 1][j - 1], {0.5, -0.5});
-            q_divergence += matrix_multiply(q_tensor[i - 1][j - 1], {-0.5, -0.5});
-
-            coord_d current_splay = matrix_multiply(q_tensor[i][j], q_divergence);
-            splay_table[i][j] = current_splay;
+#pragma omp parallel
+    {
+        // Each thread calculates a band of rows, keeping the Q-tensors of the rows neighbouring the current one.
+        int band_count = omp_get_num_threads();
+        int band = omp_get_thread_num();
+        int first_row = 1 + (int) ((long long) interior_rows * band / band_count);
+        int last_row = 1 + (int) ((long long) interior_rows * (band + 1) / band_count);
+        if (first_row < last_row) {
+            QTensorRow previous(y_size);
+            QTensorRow current(y_size);
+            QTensorRow next(y_size);
+            previous.update(x_field[first_row - 1], y_field[first_row - 1]);
+            current.update(x_field[first_row], y_field[first_row]);
+            for (int i = first_row; i < last_row; i++) {
+                assert((x_field[i].size() == y_field[i].size()));
+                next.update(x_field[i + 1], y_field[i + 1]);
+                splayRow(previous, current, next, splay_table[i]);
+                std::swap(previous, current);
+                std::swap(current, next);
+            }
         }
     }
-    // Use splay vector values from edge adjacent elements
-    size_t x_size = splay_table.size();
-    size_t y_size = splay_table[0].size();
-    for (int i = 0; i < x_size; i++) {
-        splay_table[i][0] = splay_table[i][1];
-        splay_table[i][y_size - 1] = splay_table[i][y_size - 2];
-    }
-    for (int i = 0; i < y_size; i++) {
-        splay_table[0][i] = splay_table[1][i];
-        splay_table[x_size - 1][i] = splay_table[x_size - 2][i];
-    }
+    splay_table.front() = splay_table[1];
+    splay_table.back() = splay_table[x_size - 2];
     return splay_table;
 }
 
@@ -40,6 +40,8 @@ int sgn(double number);
 
 double decimalPart(double number);
 
+/// Calculates the splay vector of the director field in a single pass, without storing the normalised director or its
+/// Q-tensor
 std::vector<std::vector<coord_d>>
 splayVector(const std::vector<std::vector<double>> &x_field, const std::vector<std::vector<double>> &y_field,
             int threads);
@@ -110,6 +112,11 @@ void adjustRowsAndColumns(std::vector<std::vector<T>> &array, const std::vector<
                           const std::vector<int> &columns_to_remove) {
     adjust_rows(array, rows_to_remove);
     adjust_columns(array, columns_to_remove);
+    // Erasing does not release the memory of the removed margins
+    array.shrink_to_fit();
+    for (auto &row: array) {
+        row.shrink_to_fit();
+    }
 }
 
 /// Minimum value of 2D vector array
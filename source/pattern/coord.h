@@ -25,6 +25,7 @@
 #ifndef VECTOR_SLICER_COORD_H
 #define VECTOR_SLICER_COORD_H
 
+#include <cstdint>
 #include <vector>
 #include <set>
 #include <unordered_set>
@@ -125,14 +126,20 @@ inline double norm(const coord_d &pt) { return pt.norm(); }
 
 inline coord_d normalized(const coord_d &pt) { return pt.normalized(); }
 
+/// Packs the coordinate into 32 bits and mixes them with the finaliser of MurmurHash3
 struct coord_hash {
 public:
-    unsigned int operator()(const coord &x) const {
-        return (int) x.x * (int) x.x - (int) x.y ;
+    uint32_t operator()(const coord &x) const {
+        uint32_t hash = (uint32_t) (uint16_t) x.x << 16 | (uint16_t) x.y;
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6b;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35;
+        hash ^= hash >> 16;
+        return hash;
     }
 };
 
-using coord_set = std::unordered_set<coord, coord_hash>;
 using coord_sequence = std::set<coord>;
 using coord_vector = std::vector<coord>;
 
@@ -0,0 +1,334 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 19/10/2026.
+//
+
+#ifndef VECTOR_SLICER_COORD_SET_H
+#define VECTOR_SLICER_COORD_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "coord.h"
+
+/// \brief Flat open addressing hash table of coordinates with linear probing. Entries are stored contiguously in the
+/// order of insertion and are iterated in that order, independently of the hash and of the standard library. Erased
+/// entries are skipped until the table is rebuilt.
+template<typename Entry>
+class FlatCoordTable {
+    static constexpr int32_t EMPTY_SLOT = -1;
+    static constexpr int32_t ERASED_SLOT = -2;
+    static constexpr size_t MISSING = SIZE_MAX;
+
+    /// Packed coordinate and the index of its entry, or EMPTY_SLOT or ERASED_SLOT. The key is kept in the slot, so that
+    /// the probing does not touch the entries.
+    struct Slot {
+        uint32_t key;
+        int32_t entry;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<uint8_t> is_erased;
+    /// The number of slots is a power of two.
+    std::vector<Slot> slots;
+    size_t live_entries = 0;
+    /// All entries before it are erased, so that repeatedly taking the first entry does not scan them again.
+    mutable size_t first_live_entry = 0;
+
+    size_t firstLiveEntry() const {
+        while (first_live_entry < entries.size() && is_erased[first_live_entry]) {
+            first_live_entry++;
+        }
+        return first_live_entry;
+    }
+
+    static_assert(sizeof(coord::x) <= sizeof(uint16_t) && sizeof(coord::y) <= sizeof(uint16_t),
+                  "Packed keys have to hold the whole coordinate, as the slots are compared only by them.");
+
+    /// Both components of the coordinate in a single word, which identifies it uniquely
+    static uint32_t packedKey(const coord &key) { return (uint32_t) (uint16_t) key.x << 16 | (uint16_t) key.y; }
+
+    static const coord &keyOf(const coord &entry) { return entry; }
+
+    size_t findSlot(const coord &key) const {
+        if (slots.empty()) {
+            return MISSING;
+        }
+        size_t mask = slots.size() - 1;
+        uint32_t packed_key = packedKey(key);
+        for (size_t slot = coord_hash()(key) & mask;; slot = (slot + 1) & mask) {
+            if (slots[slot].entry == EMPTY_SLOT) {
+                return MISSING;
+            }
+            if (slots[slot].entry >= 0 && slots[slot].key == packed_key) {
+                return slot;
+            }
+        }
+    }
+
+    /// Drops the erased entries and distributes the remaining ones over slots, at most a quarter of which are used
+    void rebuild(size_t minimal_entries) {
+        size_t capacity = 16;
+        while (capacity < 4 * (minimal_entries + 1)) {
+            capacity *= 2;
+        }
+        if (live_entries != entries.size()) {
+            std::vector<Entry> live;
+            live.reserve(live_entries);
+            for (size_t i = 0; i < entries.size(); i++) {
+                if (!is_erased[i]) {
+                    live.emplace_back(std::move(entries[i]));
+                }
+            }
+            entries = std::move(live);
+            is_erased.assign(entries.size(), 0);
+        }
+        first_live_entry = 0;
+
+        slots.assign(capacity, {0, EMPTY_SLOT});
+        size_t mask = capacity - 1;
+        for (size_t i = 0; i < entries.size(); i++) {
+            const coord &key = keyOf(entries[i]);
+            size_t slot = coord_hash()(key) & mask;
+            while (slots[slot].entry != EMPTY_SLOT) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = {packedKey(key), (int32_t) i};
+        }
+    }
+
+public:
+    template<bool is_const>
+    class Iterator {
+        using Table = typename std::conditional<is_const, const FlatCoordTable, FlatCoordTable>::type;
+        Table *table;
+        size_t index;
+
+        void skipErased() {
+            while (index < table->entries.size() && table->is_erased[index]) {
+                index++;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<is_const, const Entry *, Entry *>::type;
+        using reference = typename std::conditional<is_const, const Entry &, Entry &>::type;
+
+        Iterator(Table *table, size_t index) : table(table), index(index) { skipErased(); }
+
+        reference operator*() const { return table->entries[index]; }
+
+        pointer operator->() const { return &table->entries[index]; }
+
+        Iterator &operator++() {
+            index++;
+            skipErased();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const { return index == other.index; }
+
+        bool operator!=(const Iterator &other) const { return index != other.index; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return {this, firstLiveEntry()}; }
+
+    iterator end() { return {this, entries.size()}; }
+
+    const_iterator begin() const { return {this, firstLiveEntry()}; }
+
+    const_iterator end() const { return {this, entries.size()}; }
+
+    /// First entry in the order of insertion, which is not erased
+    const Entry &front() const { return entries[firstLiveEntry()]; }
+
+    iterator find(const coord &key) {
+        size_t slot = findSlot(key);
+        return slot == MISSING ? end() : iterator(this, slots[slot].entry);
+    }
+
+    const_iterator find(const coord &key) const {
+        size_t slot = findSlot(key);
+        return slot == MISSING ? end() : const_iterator(this, slots[slot].entry);
+    }
+
+    [[nodiscard]] size_t count(const coord &key) const { return findSlot(key) == MISSING ? 0 : 1; }
+
+    [[nodiscard]] bool contains(const coord &key) const { return findSlot(key) != MISSING; }
+
+    /// Constructs the entry from the arguments if the key is not present
+    template<typename... Args>
+    std::pair<iterator, bool> emplaceKey(const coord &key, Args &&... args) {
+        size_t slot = findSlot(key);
+        if (slot != MISSING) {
+            return {iterator(this, slots[slot].entry), false};
+        }
+        // Erased slots are counted as used, so that there is always an empty slot ending the probing.
+        if (2 * (entries.size() + 1) > slots.size()) {
+            rebuild(live_entries + 1);
+        }
+        size_t mask = slots.size() - 1;
+        slot = coord_hash()(key) & mask;
+        while (slots[slot].entry >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = {packedKey(key), (int32_t) entries.size()};
+        entries.emplace_back(std::forward<Args>(args)...);
+        is_erased.push_back(0);
+        live_entries++;
+        return {iterator(this, entries.size() - 1), true};
+    }
+
+    size_t erase(const coord &key) {
+        size_t slot = findSlot(key);
+        if (slot == MISSING) {
+            return 0;
+        }
+        is_erased[slots[slot].entry] = 1;
+        slots[slot].entry = ERASED_SLOT;
+        live_entries--;
+        return 1;
+    }
+
+    void reserve(size_t entry_count) {
+        if (4 * (entry_count + 1) > slots.size()) {
+            rebuild(entry_count);
+        }
+    }
+
+    void clear() {
+        entries.clear();
+        is_erased.clear();
+        slots.clear();
+        live_entries = 0;
+        first_live_entry = 0;
+    }
+
+    [[nodiscard]] size_t size() const { return live_entries; }
+
+    [[nodiscard]] bool empty() const { return live_entries == 0; }
+};
+
+
+/// Set of coordinates, replacing std::unordered_set<coord>
+class CoordSet : public FlatCoordTable<coord> {
+public:
+    CoordSet() = default;
+
+    CoordSet(std::initializer_list<coord> coordinates) { insert(coordinates.begin(), coordinates.end()); }
+
+    template<typename InputIterator>
+    CoordSet(InputIterator first, InputIterator last) { insert(first, last); }
+
+    std::pair<iterator, bool> insert(const coord &coordinate) { return emplaceKey(coordinate, coordinate); }
+
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+};
+
+
+/// Set of coordinates within a grid, whose membership is stored as a dense mask instead of a hash table. Like CoordSet,
+/// it is iterated in the order of insertion. Coordinates outside of the grid are never contained.
+class DenseCoordSet {
+    int rows;
+    int row_length;
+    /// Index of the entry of each coordinate of the grid increased by one, or zero if the coordinate is not contained
+    std::vector<uint32_t> entry_of;
+    std::vector<coord> entries;
+    size_t live_entries = 0;
+    mutable size_t first_live_entry = 0;
+
+    [[nodiscard]] bool isInGrid(const coord &coordinate) const {
+        return 0 <= coordinate.x && coordinate.x < rows && 0 <= coordinate.y && coordinate.y < row_length;
+    }
+
+    [[nodiscard]] size_t index(const coord &coordinate) const {
+        return (size_t) coordinate.x * row_length + coordinate.y;
+    }
+
+public:
+    DenseCoordSet(int rows, int row_length) : rows(rows), row_length(row_length),
+                                              entry_of((size_t) rows * row_length, 0) {}
+
+    [[nodiscard]] bool contains(const coord &coordinate) const {
+        return isInGrid(coordinate) && entry_of[index(coordinate)];
+    }
+
+    bool insert(const coord &coordinate) {
+        if (!isInGrid(coordinate) || entry_of[index(coordinate)]) {
+            return false;
+        }
+        entries.emplace_back(coordinate);
+        entry_of[index(coordinate)] = (uint32_t) entries.size();
+        live_entries++;
+        return true;
+    }
+
+    size_t erase(const coord &coordinate) {
+        if (!contains(coordinate)) {
+            return 0;
+        }
+        entry_of[index(coordinate)] = 0;
+        live_entries--;
+        return 1;
+    }
+
+    /// First coordinate in the order of insertion, which is not erased
+    [[nodiscard]] const coord &front() const {
+        while (first_live_entry < entries.size() &&
+               entry_of[index(entries[first_live_entry])] != first_live_entry + 1) {
+            first_live_entry++;
+        }
+        return entries[first_live_entry];
+    }
+
+    [[nodiscard]] size_t size() const { return live_entries; }
+
+    [[nodiscard]] bool empty() const { return live_entries == 0; }
+};
+
+
+using coord_set = CoordSet;
+
+
+#endif //VECTOR_SLICER_COORD_SET_H
@@ -36,14 +36,19 @@
 #include <iterator>
 #include <random>
 #include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <omp.h>
 
 #include "importing_and_exporting/table_reading.h"
+#include "importing_and_exporting/pattern_snapshot.h"
 #include "auxiliary/simple_math_operations.h"
 #include "auxiliary/perimeter.h"
 #include "auxiliary/line_operations.h"
 #include "auxiliary/line_thinning.h"
 #include "auxiliary/valarray_operations.h"
 #include "auxiliary/vector_operations.h"
+#include "auxiliary/hashing.h"
 #include "simulation/filling_method_config.h"
 
 #include "vector_slicer_config.h"
@@ -80,27 +85,17 @@ DesiredPattern::DesiredPattern(std::vector<std::vector<uint8_t>> shape_field, st
 DesiredPattern::DesiredPattern(const std::string &shape_filename, const std::string &x_field_filename,
                                const std::string &y_field_filename, bool is_splay_filling_enabled, int threads,
                                const FillingMethodConfig &filling) :
-        DesiredPattern(readFileToTableInt(shape_filename), readFileToTableDouble(x_field_filename),
-                       readFileToTableDouble(y_field_filename), is_splay_filling_enabled, threads, filling) {}
+        DesiredPattern(readFileToTableInt(shape_filename, threads), readFileToTableDouble(x_field_filename, threads),
+                       readFileToTableDouble(y_field_filename, threads), is_splay_filling_enabled, threads, filling) {}
 
 
 DesiredPattern::DesiredPattern(const std::string &shape_filename, const std::string &theta_field_filename,
                                bool is_splay_filling_enabled, int threads, const FillingMethodConfig &filling) {
-    std::vector<vecd> theta_field = readFileToTableDouble(theta_field_filename);
     std::vector<vecd> x_field;
     std::vector<vecd> y_field;
-    for (const auto &theta_row: theta_field) {
-        vecd x_row;
-        vecd y_row;
-        for (const auto &theta: theta_row) {
-            x_row.push_back(cos(theta));
-            y_row.push_back(sin(theta));
-        }
-        x_field.push_back(x_row);
-        y_field.push_back(y_row);
-    }
-    *this = DesiredPattern(readFileToTableInt(shape_filename), x_field, y_field, is_splay_filling_enabled,
-                           threads, filling);
+    readFileToDirectorTables(theta_field_filename, x_field, y_field, threads);
+    *this = DesiredPattern(readFileToTableInt(shape_filename, threads), std::move(x_field), std::move(y_field),
+                           is_splay_filling_enabled, threads, filling);
 }
 
 
@@ -109,25 +104,7 @@ void DesiredPattern::updateProperties() {
     auto t1 = std::chrono::high_resolution_clock::now();
 #endif
     adjustMargins();
-    if (!isSplayProvided()) {
-        splay_vector_array = splayVector(x_field_preferred, y_field_preferred, threads);
-        splay_array = vectorArrayNorm(splay_vector_array, threads);
-
-        if (shape_matrix.size() != splay_array.size()) {
-            throw std::runtime_error("Incompatible x-size of splay array and shape array.");
-        } else if (shape_matrix.front().size() != splay_array.front().size()) {
-            throw std::runtime_error("Incompatible y-size of splay array and shape array.");
-        }
-    }
-
     std::cout << "Pattern dimensions: " << dimensions[0] << "x" << dimensions[1] << std::endl;
-    if (is_splay_filling_enabled) {
-        findLineDensityMinima();
-    }
-    int bin_number = std::min(shape_matrix.size(), shape_matrix[0].size()) / 10;
-
-    splay_sorted_empty_spots = binBySplay(bin_number);
-    perimeter_list = findSeparatedPerimeters(shape_matrix, dimensions, splay_vector_array);
     is_pattern_updated = true;
 #ifdef TIMING
     time_t end_time;
@@ -154,9 +131,10 @@ void DesiredPattern::adjustMargins() {
     adjustRowsAndColumns(shape_matrix, null_rows, null_columns);
     adjustRowsAndColumns(x_field_preferred, null_rows, null_columns);
     adjustRowsAndColumns(y_field_preferred, null_rows, null_columns);
-    if (!splay_vector_array.empty()) {
-        adjustRowsAndColumns(splay_vector_array, null_rows, null_columns);
-        adjustRowsAndColumns(splay_array, null_rows, null_columns);
+    if (is_splay_provided) {
+        std::vector<std::vector<coord_d>> provided_splay = *splay_vector_array.peek();
+        adjustRowsAndColumns(provided_splay, null_rows, null_columns);
+        splay_vector_array.set(std::move(provided_splay));
     }
 
     dimensions = getTableDimensions(shape_matrix);
@@ -216,7 +194,16 @@ const std::vector<int> &DesiredPattern::getDimensions() const {
 
 
 const std::vector<std::vector<coord>> &DesiredPattern::getPerimeterList() const {
-    return perimeter_list;
+    return perimeter_list.get([this]() {
+        return findSeparatedPerimeters(shape_matrix, dimensions, getSplayVectorArray());
+    });
+}
+
+
+const IslandMap &DesiredPattern::getIslandMap() const {
+    return island_map.get([this]() {
+        return findIslands(shape_matrix);
+    });
 }
 
 
@@ -235,7 +222,7 @@ const std::vector<vecd> &DesiredPattern::getYFieldPreferred() const {
 }
 
 double DesiredPattern::getSplay(const coord &point) const {
-    return splay_array[point.x][point.y];
+    return norm(getSplayVectorArray()[point.x][point.y]);
 }
 
 
@@ -252,7 +239,7 @@ std::vector<coord> findFillableCells(const std::vector<std::vector<uint8_t>> &sh
 }
 
 
-std::vector<std::vector<coord>> DesiredPattern::binBySplay(unsigned int bins) {
+std::vector<std::vector<coord>> DesiredPattern::binBySplay(unsigned int bins) const {
     std::vector<coord> unsorted_coordinates = findFillableCells(shape_matrix);
     if (unsorted_coordinates.empty()) {
         return {};
@@ -278,7 +265,10 @@ std::vector<std::vector<coord>> DesiredPattern::binBySplay(unsigned int bins) {
 }
 
 const std::vector<std::vector<coord>> &DesiredPattern::getSplaySortedEmptySpots() const {
-    return splay_sorted_empty_spots;
+    return splay_sorted_empty_spots.get([this]() {
+        int bin_number = std::min(shape_matrix.size(), shape_matrix[0].size()) / 10;
+        return binBySplay(bin_number);
+    });
 }
 
 bool DesiredPattern::isVectorFilled() const {
@@ -295,21 +285,34 @@ bool DesiredPattern::isSplayProvided() const {
 
 
 void DesiredPattern::setSplayVector(const std::string &path) {
-    splay_vector_array = readFileToTableDoubleVector(path);
+    std::vector<std::vector<coord_d>> provided_splay = readFileToTableDoubleVector(path, threads);
 
-    if (shape_matrix.size() != splay_vector_array.size()) {
+    if (shape_matrix.size() != provided_splay.size()) {
         std::cout << "Incompatible x-size of splay array and shape array. Defaulting to numerical calculation."
                   << std::endl;
-    } else if (shape_matrix.front().size() != splay_vector_array.front().size()) {
+    } else if (shape_matrix.front().size() != provided_splay.front().size()) {
         std::cout << "Incompatible y-size of splay array and shape array. Defaulting to numerical calculation."
                   << std::endl;
     } else {
-        splay_array = vectorArrayNorm(splay_vector_array, threads);
+        splay_vector_array.set(std::move(provided_splay));
         is_splay_provided = true;
     }
 }
 
 
+const std::vector<std::vector<coord_d>> &DesiredPattern::getSplayVectorArray() const {
+    return splay_vector_array.get([this]() {
+        std::vector<std::vector<coord_d>> splay = splayVector(x_field_preferred, y_field_preferred, threads);
+        if (shape_matrix.size() != splay.size()) {
+            throw std::runtime_error("Incompatible x-size of splay array and shape array.");
+        } else if (shape_matrix.front().size() != splay.front().size()) {
+            throw std::runtime_error("Incompatible y-size of splay array and shape array.");
+        }
+        return splay;
+    });
+}
+
+
 /// Returns vector along the director in the same direction as previous displacement
 coord_d DesiredPattern::getMove(const coord_d &position, const coord_d &displacement) const {
     coord_d undirected_move = getDirector(position);
@@ -337,22 +340,18 @@ double distance(const coord &first, const coord &second) {
 
 
 void DesiredPattern::updateIntegralCurveInDirection(coord current_coord, coord_d current_position,
-                                                    coord_d current_travel_direction) {
-
-    auto start = std::chrono::system_clock::now();
-    is_coordinate_used[current_coord.x][current_coord.y] = 0;
-
+                                                    coord_d current_travel_direction, coord_vector &integral_curve,
+                                                    coord_set &curve_coordinates) const {
     while (
             isInShape(current_coord) &&
-            (!is_coordinate_in_curve[current_coord.x][current_coord.y] ||
-             (integral_curve_coords.back() == current_coord))
+            (!curve_coordinates.contains(current_coord) ||
+             (integral_curve.back() == current_coord))
             ) {
-        is_coordinate_in_curve[current_coord.x][current_coord.y] = 1;
+        curve_coordinates.insert(current_coord);
         // Avoid doubling the entries.
-        if (integral_curve_coords.empty() || current_coord != integral_curve_coords.back()) {
-            integral_curve_coords.emplace_back(current_coord);
+        if (integral_curve.empty() || current_coord != integral_curve.back()) {
+            integral_curve.emplace_back(current_coord);
         }
-        is_coordinate_used[current_coord.x][current_coord.y] = 0;
         current_travel_direction = getMove(current_position, current_travel_direction);
         current_position = current_position + current_travel_direction;
         current_coord = coord(current_position);
@@ -360,30 +359,31 @@ void DesiredPattern::updateIntegralCurveInDirection(coord current_coord, coord_d
 }
 
 
-void DesiredPattern::updateIntegralCurve(const coord &starting_coordinate) {
+void DesiredPattern::updateIntegralCurve(const coord &starting_coordinate, coord_vector &integral_curve,
+                                         coord_set &curve_coordinates) const {
     coord_d current_position = to_coord_d(starting_coordinate);
     coord_d current_travel_direction = getDirector(current_position);
 
     coord current_coord = starting_coordinate;
 
-    updateIntegralCurveInDirection(current_coord, current_position, current_travel_direction);
-    if (!integral_curve_coords.empty()) {
-        std::reverse(integral_curve_coords.begin(), integral_curve_coords.end());
+    integral_curve.clear();
+    updateIntegralCurveInDirection(current_coord, current_position, current_travel_direction, integral_curve,
+                                   curve_coordinates);
+    if (!integral_curve.empty()) {
+        std::reverse(integral_curve.begin(), integral_curve.end());
     }
 
-    updateIntegralCurveInDirection(current_coord, current_position, -1 * current_travel_direction);
-
-    for (auto &coord: integral_curve_coords) {
-        is_coordinate_in_curve[coord.x][coord.y] = 0;
-    }
+    updateIntegralCurveInDirection(current_coord, current_position, -1 * current_travel_direction, integral_curve,
+                                   curve_coordinates);
+    curve_coordinates.clear();
 }
 
-coord_d DesiredPattern::getSplayVector(const coord &coordinate) {
-    return splay_vector_array[coordinate.x][coordinate.y];
+coord_d DesiredPattern::getSplayVector(const coord &coordinate) const {
+    return getSplayVectorArray()[coordinate.x][coordinate.y];
 }
 
 /// The magnitude splay in the direction from back to front.
-std::vector<double> DesiredPattern::directedSplayMagnitude(const coord_vector &integral_curve) {
+std::vector<double> DesiredPattern::directedSplayMagnitude(const coord_vector &integral_curve) const {
     std::vector<double> directed_splay(integral_curve.size());
 
     coord_d displacement = to_coord_d(integral_curve[0] - integral_curve[1]);
@@ -451,7 +451,7 @@ bool isValidSplayFreeLineEnd(bool is_boundary_last_in_curve, double splay) {
     }
 }
 
-bool DesiredPattern::isBoundary(const coord &coordinate) {
+bool DesiredPattern::isBoundary(const coord &coordinate) const {
     coord coord_i = {coordinate.x, coordinate.y};
     for (int i = -1; i <= 1; i++) {
         for (int j = -1; j <= 1; j++) {
@@ -465,29 +465,25 @@ bool DesiredPattern::isBoundary(const coord &coordinate) {
     return false;
 }
 
-coord_set DesiredPattern::findPointsOfZeroSplay(const coord &starting_coordinate) {
-    updateIntegralCurve(starting_coordinate);
-    if (integral_curve_coords.empty()) {
+coord_set DesiredPattern::findPointsOfZeroSplay(const coord_vector &integral_curve) const {
+    if (integral_curve.empty()) {
         return {};
     }
 
     /// The splay magnitude in the direction from back to front.
-    std::vector<double> directed_splay = directedSplayMagnitude(integral_curve_coords);
+    std::vector<double> directed_splay = directedSplayMagnitude(integral_curve);
 
     coord_vector current_splay_free_line;
     coord_set valid_coords_set;
     coord_set zero_splay_boundary_nodes;
 
-    bool is_integral_curve_looped = isLoopedAnywhere(integral_curve_coords);
+    bool is_integral_curve_looped = isLoopedAnywhere(integral_curve);
     bool is_last_in_curve = !is_integral_curve_looped;
 
-    while (!integral_curve_coords.empty()) {
-        coord coordinate = integral_curve_coords.back();
-        is_coordinate_in_curve[coordinate.x][coordinate.y] = 0;
-        integral_curve_coords.pop_back();
-        if (integral_curve_coords.empty()) { is_last_in_curve = !is_integral_curve_looped; }
-        double splay = directed_splay.back();
-        directed_splay.pop_back();
+    for (size_t i = integral_curve.size(); i-- > 0;) {
+        coord coordinate = integral_curve[i];
+        if (i == 0) { is_last_in_curve = !is_integral_curve_looped; }
+        double splay = directed_splay[i];
         bool is_current_boundary = isBoundary(coordinate);
         if (is_current_boundary) { zero_splay_boundary_nodes.insert(coordinate); }
 
@@ -537,22 +533,6 @@ coord_vector shape_coordinates_vector(const std::vector<std::vector<uint8_t>> &s
 }
 
 
-void DesiredPattern::initialiseSplaySeeding() {
-    is_coordinate_used = std::vector<std::vector<uint8_t>>(shape_matrix.size());
-    is_coordinate_in_curve = std::vector<std::vector<uint8_t>>(shape_matrix.size());
-    for (int i = 0; i < shape_matrix.size(); i++) {
-        is_coordinate_used[i].insert(is_coordinate_used[i].end(), shape_matrix[i].begin(), shape_matrix[i].end());
-        is_coordinate_in_curve[i] = std::vector<uint8_t>(shape_matrix[i].size(), 0);
-    }
-    coord_in_shape = shape_coordinates_vector(shape_matrix);
-    // We are reshuffling in order to analyse the coordinates semi-randomly.
-    std::shuffle(coord_in_shape.begin(), coord_in_shape.end(), std::mt19937(0));
-}
-
-bool DesiredPattern::isCoordinateViable(const coord &coordinate) {
-    return is_coordinate_used[coordinate.x][coordinate.y];
-}
-
 void exportCoord(const coord_set &vec, const fs::path &output) {
     std::ofstream file(output.string());
     if (file.is_open()) {
@@ -563,25 +543,57 @@ void exportCoord(const coord_set &vec, const fs::path &output) {
     file.close();
 }
 
-void DesiredPattern::findLineDensityMinima() {
-    auto t0 = std::chrono::system_clock::now();
+std::vector<std::vector<coord>> DesiredPattern::findLineDensityMinima() const {
     std::cout << "Beginning search for seeding lines." << std::endl;
-    initialiseSplaySeeding();
+    // The splay is calculated before the curves are traced in parallel, so that it can use all the threads.
+    (void) getSplayVectorArray();
+    // Initialised as original shape matrix and 1's are replaced with 0's once they are considered by the algorithm.
+    std::vector<std::vector<uint8_t>> is_coordinate_used = shape_matrix;
+    coord_vector coord_in_shape = shape_coordinates_vector(shape_matrix);
+    // We are reshuffling in order to analyse the coordinates semi-randomly.
+    std::shuffle(coord_in_shape.begin(), coord_in_shape.end(), std::mt19937(0));
     size_t fillable_point_count = coord_in_shape.size();
 
+    std::vector<coord_set> curve_coordinates(threads);
+    coord_vector starting_coordinates;
+    std::vector<coord_vector> integral_curves(threads);
+    std::vector<coord_set> points_of_minimum_density(threads);
+
     coord_set solution_set;
+    omp_set_num_threads(threads);
     while (!coord_in_shape.empty()) {
-        coord starting_coordinate = coord_in_shape.back();
-        coord_in_shape.pop_back();
-        if (!isCoordinateViable(starting_coordinate)) {
-            continue;
+        // Each thread traces one of the next viable starting coordinates in the order of the sequential search.
+        starting_coordinates.clear();
+        while (!coord_in_shape.empty() && (int) starting_coordinates.size() < threads) {
+            coord starting_coordinate = coord_in_shape.back();
+            coord_in_shape.pop_back();
+            if (is_coordinate_used[starting_coordinate.x][starting_coordinate.y]) {
+                starting_coordinates.emplace_back(starting_coordinate);
+            }
+        }
+
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < starting_coordinates.size(); i++) {
+            updateIntegralCurve(starting_coordinates[i], integral_curves[i], curve_coordinates[omp_get_thread_num()]);
+            points_of_minimum_density[i] = findPointsOfZeroSplay(integral_curves[i]);
+        }
+
+        // Curves are merged in order, discarding the ones starting on a curve merged before them, which would not
+        // have been traced by the sequential search.
+        for (int i = 0; i < starting_coordinates.size(); i++) {
+            if (!is_coordinate_used[starting_coordinates[i].x][starting_coordinates[i].y]) {
+                continue;
+            }
+            is_coordinate_used[starting_coordinates[i].x][starting_coordinates[i].y] = 0;
+            for (auto &coordinate: integral_curves[i]) {
+                is_coordinate_used[coordinate.x][coordinate.y] = 0;
+            }
+            solution_set.insert(points_of_minimum_density[i].begin(), points_of_minimum_density[i].end());
         }
 
         double progress = (1 - (double) coord_in_shape.size() / (double) fillable_point_count) * 100;
         printf("\r%.2f%% coordinates analysed       ", progress);
         fflush(stdout);
-        coord_set point_of_minimum_density = findPointsOfZeroSplay(starting_coordinate);
-        solution_set.insert(point_of_minimum_density.begin(), point_of_minimum_density.end());
     }
 
     std::cout << "\rSearch for seeding lines complete." << std::endl;
@@ -591,7 +603,7 @@ void DesiredPattern::findLineDensityMinima() {
     if (solution_set.empty()) {
         std::cout << "No splay seeding lines found, which indicates a pattern being composed of +1 defects. "
                      "Proceeding with dual seeding. " << std::endl;
-        return;
+        return {};
     }
     std::vector<std::vector<coord>> separated_lines_of_minimal_density = separateIntoLines(solution_set,
                                                                                            {0, 0}, sqrt(2));
@@ -601,11 +613,69 @@ void DesiredPattern::findLineDensityMinima() {
     } else {
         std::cout << "\t 1 splay seeding line found." << std::endl;
     }
-    lines_of_minimal_density = separated_lines_of_minimal_density;
+    return separated_lines_of_minimal_density;
 }
 
 const std::vector<std::vector<coord>> &DesiredPattern::getLineDensityMinima() const {
-    return lines_of_minimal_density;
+    return lines_of_minimal_density.get([this]() {
+        if (!is_splay_filling_enabled) {
+            return std::vector<std::vector<coord>>();
+        }
+        return findLineDensityMinima();
+    });
+}
+
+bool DesiredPattern::prepareSeeding(fillingMethod seeding_method) {
+    isPatternUpdated();
+    bool is_calculated = !splay_sorted_empty_spots.isInitialised();
+    (void) getSplaySortedEmptySpots();
+    if (seeding_method == Splay && is_splay_provided) {
+        is_calculated |= !lines_of_minimal_density.isInitialised();
+        (void) getLineDensityMinima();
+    } else if (seeding_method == Splay || seeding_method == Perimeter) {
+        is_calculated |= !perimeter_list.isInitialised();
+        (void) getPerimeterList();
+    }
+    (void) getIslandMap();
+    if (!is_splay_provided) {
+        splay_vector_array.reset();
+    }
+    return is_calculated;
+}
+
+
+template<typename T>
+size_t tableBytes(const std::vector<std::vector<T>> &table) {
+    size_t bytes = table.capacity() * sizeof(std::vector<T>);
+    for (auto &row: table) {
+        bytes += row.capacity() * sizeof(T);
+    }
+    return bytes;
+}
+
+template<typename T>
+size_t tableBytes(const Lazy<std::vector<std::vector<T>>> &table) {
+    const std::vector<std::vector<T>> *value = table.peek();
+    return value == nullptr ? 0 : tableBytes(*value);
+}
+
+size_t islandMapBytes(const Lazy<IslandMap> &island_map) {
+    const IslandMap *value = island_map.peek();
+    return value == nullptr ? 0 : value->labels.getAllocatedBytes() + value->islands.capacity() * sizeof(Island);
+}
+
+void DesiredPattern::printMemoryUsage() const {
+    const double bytes_per_megabyte = 1024 * 1024;
+    std::ostringstream usage;
+    usage << std::fixed << std::setprecision(2)
+          << "Pattern memory usage: shape " << tableBytes(shape_matrix) / bytes_per_megabyte
+          << " MB, director " << (tableBytes(x_field_preferred) + tableBytes(y_field_preferred)) / bytes_per_megabyte
+          << " MB, splay " << tableBytes(splay_vector_array) / bytes_per_megabyte
+          << " MB, root points " << tableBytes(splay_sorted_empty_spots) / bytes_per_megabyte
+          << " MB, perimeters " << tableBytes(perimeter_list) / bytes_per_megabyte
+          << " MB, splay seeding lines " << tableBytes(lines_of_minimal_density) / bytes_per_megabyte
+          << " MB, islands " << islandMapBytes(island_map) / bytes_per_megabyte << " MB.";
+    std::cout << usage.str() << std::endl;
 }
 
 int DesiredPattern::getSortingMethod() const {
@@ -627,3 +697,69 @@ double DesiredPattern::getMinimalLineLength() const {
 bool DesiredPattern::isPointsRemoved() const {
     return is_points_removed;
 }
+
+uint64_t DesiredPattern::getContentHash() const {
+    StableHash hash;
+    hash.add(std::string(SLICER_VER));
+    hash.add(dimensions);
+    hash.add(shape_matrix);
+    hash.add(x_field_preferred);
+    hash.add(y_field_preferred);
+    hash.add(is_splay_provided);
+    if (is_splay_provided) {
+        hash.add(*splay_vector_array.peek());
+    }
+    hash.add(is_splay_filling_enabled);
+    hash.add(is_vector_filled);
+    hash.add(minimal_line_length);
+    hash.add(is_points_removed);
+    hash.add(discontinuity_behaviour);
+    hash.add(discontinuity_threshold_cos);
+    hash.add(splay_line_behaviour);
+    return hash.getHash();
+}
+
+void DesiredPattern::writeSnapshot(SnapshotWriter &writer) const {
+    isPatternUpdated();
+    writer.write(dimensions);
+    writer.write(shape_matrix);
+    writer.write(x_field_preferred);
+    writer.write(y_field_preferred);
+    writer.write(splay_vector_array);
+    writer.write(perimeter_list);
+    writer.write(splay_sorted_empty_spots);
+    writer.write(lines_of_minimal_density);
+    writer.write(is_vector_filled);
+    writer.write(is_vector_sorted);
+    writer.write(is_splay_provided);
+    writer.write(is_splay_filling_enabled);
+    writer.write(sorting_method);
+    writer.write(minimal_line_length);
+    writer.write(is_points_removed);
+    writer.write(discontinuity_behaviour);
+    writer.write(discontinuity_threshold_cos);
+    writer.write(splay_line_behaviour);
+}
+
+void DesiredPattern::readSnapshot(SnapshotReader &reader, int threads) {
+    reader.read(dimensions);
+    reader.read(shape_matrix);
+    reader.read(x_field_preferred);
+    reader.read(y_field_preferred);
+    reader.read(splay_vector_array);
+    reader.read(perimeter_list);
+    reader.read(splay_sorted_empty_spots);
+    reader.read(lines_of_minimal_density);
+    reader.read(is_vector_filled);
+    reader.read(is_vector_sorted);
+    reader.read(is_splay_provided);
+    reader.read(is_splay_filling_enabled);
+    reader.read(sorting_method);
+    reader.read(minimal_line_length);
+    reader.read(is_points_removed);
+    reader.read(discontinuity_behaviour);
+    reader.read(discontinuity_threshold_cos);
+    reader.read(splay_line_behaviour);
+    this->threads = threads;
+    is_pattern_updated = true;
+}
@@ -32,7 +32,10 @@
 #include <vector>
 #include <set>
 #include "simulation/filling_method_config.h"
+#include "filling_config.h"
 #include "auxiliary/line_thinning.h"
+#include "auxiliary/lazy.h"
+#include "auxiliary/islands.h"
 
 #define SORT_NEAREST_NEIGHBOUR 0
 #define SORT_SEED_LINE 1
@@ -43,19 +46,27 @@
 
 using vecd = std::vector<double>;
 
+class SnapshotWriter;
+
+class SnapshotReader;
+
 /// \brief Contains the information about the desired vector field such as its shape and local preferred direction, together
-/// with the information about its continuous edges
+/// with the information about its continuous edges. Structures used only by some of the seeding methods are calculated
+/// on their first use.
 class DesiredPattern {
     std::vector<int> dimensions;
     /// Each element is one continuous edge of the pattern
-    std::vector<std::vector<coord>> perimeter_list;
+    Lazy<std::vector<std::vector<coord>>> perimeter_list;
     std::vector<std::vector<uint8_t>> shape_matrix;
-    std::vector<std::vector<coord_d>> splay_vector_array;
+    /// Splay vector, either read from the splay file or calculated from the director. The calculated one is released
+    /// once the seeding structures are prepared, and calculated again only if it is needed afterwards.
+    Lazy<std::vector<std::vector<coord_d>>> splay_vector_array;
     std::vector<std::vector<double>> x_field_preferred;
     std::vector<std::vector<double>> y_field_preferred;
-    std::vector<std::vector<double>> splay_array;
-    std::vector<std::vector<coord>> splay_sorted_empty_spots;
-    std::vector<std::vector<coord>> lines_of_minimal_density;
+    Lazy<std::vector<std::vector<coord>>> splay_sorted_empty_spots;
+    Lazy<std::vector<std::vector<coord>>> lines_of_minimal_density;
+    /// Connected parts of the shape, which can be filled independently of each other
+    Lazy<IslandMap> island_map;
 
     bool is_vector_filled = false;
     bool is_vector_sorted = false;
@@ -75,41 +86,36 @@ class DesiredPattern {
 
     int splay_line_behaviour = SPLAY_LINE_CENTRES;
 
-    /// Splay seeding: Initialised as original shape matrix and 1's are replaced with 0's once they are considered by the algorithm.
-    std::vector<std::vector<uint8_t>> is_coordinate_used;
-    /// Splay seeding: 2D matrix initialised with 0's, which are replaced with 1's if used in the current integral curve.
-    std::vector<std::vector<uint8_t>> is_coordinate_in_curve;
-    /// Splay seeding: List of coordinates within the current integral curve.
-    coord_vector integral_curve_coords;
-    /// Splay seeding: List of all initial coords in the shape.
-    coord_vector coord_in_shape;
-
-    [[nodiscard]] std::vector<std::vector<coord>> binBySplay(unsigned int bins);
+    [[nodiscard]] std::vector<std::vector<coord>> binBySplay(unsigned int bins) const;
 
 
-    coord_set findPointsOfZeroSplay(const coord &starting_coordinate);
+    /// Splay seeding: finds the points of zero splay along the integral curve.
+    coord_set findPointsOfZeroSplay(const coord_vector &integral_curve) const;
 
     void adjustMargins();
 
 
     [[nodiscard]] coord_d getMove(const coord_d &position, const coord_d &displacement) const;
 
-    void updateIntegralCurve(const coord &starting_coordinate);
+    /// Splay seeding: traces the integral curve through the starting coordinate into integral_curve.
+    /// curve_coordinates is an empty set, which holds the coordinates of the curve while it is traced. It is owned by
+    /// the calling thread and is emptied again, so that its memory scales with the curve rather than the pattern.
+    void updateIntegralCurve(const coord &starting_coordinate, coord_vector &integral_curve,
+                             coord_set &curve_coordinates) const;
 
     void updateIntegralCurveInDirection(coord current_coord, coord_d current_position,
-                                        coord_d current_travel_direction);
+                                        coord_d current_travel_direction, coord_vector &integral_curve,
+                                        coord_set &curve_coordinates) const;
 
     coord_d getMove(const coord &position, const coord_d &displacement) const;
 
-    coord_d getSplayVector(const coord &coordinate);
+    coord_d getSplayVector(const coord &coordinate) const;
 
-    std::vector<double> directedSplayMagnitude(const coord_vector &integral_curve);
+    [[nodiscard]] const std::vector<std::vector<coord_d>> &getSplayVectorArray() const;
 
-    void initialiseSplaySeeding();
+    std::vector<double> directedSplayMagnitude(const coord_vector &integral_curve) const;
 
-    bool isCoordinateViable(const coord &coordinate);
-
-    bool isBoundary(const coord &coordinate);
+    bool isBoundary(const coord &coordinate) const;
 
     double getDirectorY(int x, int y) const;
 
@@ -160,9 +166,22 @@ public:
 
     [[nodiscard]] const std::vector<std::vector<coord>> &getLineDensityMinima() const;
 
+    [[nodiscard]] const IslandMap &getIslandMap() const;
+
+    /// Trims the margins and calculates the splay. The remaining structures are calculated on their first use.
     void updateProperties();
 
-    void findLineDensityMinima();
+    /// Calculates the structures used by the seeding method and labels the islands, so that they are not calculated
+    /// during the first fill, and releases the calculated splay. Returns whether any of the seeding structures was not
+    /// calculated before; the islands are cheap to label and are not included in the snapshot.
+    bool prepareSeeding(fillingMethod seeding_method);
+
+    /// Prints the memory used by each of the components of the pattern
+    void printMemoryUsage() const;
+
+    /// Finds the lines of zero splay by tracing the integral curves of the director in parallel. The lines are the
+    /// same as for the sequential search over the shuffled coordinates.
+    [[nodiscard]] std::vector<std::vector<coord>> findLineDensityMinima() const;
 
     void isPatternUpdated() const;
 
@@ -176,9 +195,18 @@ public:
 
     [[nodiscard]] bool isPointsRemoved() const;
 
+    /// Hash of the inputs and the filling method options that affect filling, used to identify cached evaluations.
+    [[nodiscard]] uint64_t getContentHash() const;
+
     bool isInShape(const coord_d &coordinate) const;
 
     bool isInRange(const coord &coordinate) const;
+
+    /// Writes the prepared pattern, so that it can be loaded without parsing the inputs and updating its properties.
+    void writeSnapshot(SnapshotWriter &writer) const;
+
+    /// Reads the prepared pattern written by writeSnapshot. Whether the snapshot was complete is checked by the reader.
+    void readSnapshot(SnapshotReader &reader, int threads);
 };
 
 
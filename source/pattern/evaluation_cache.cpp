@@ -0,0 +1,268 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 18/10/2026.
+//
+
+#include "evaluation_cache.h"
+#include "auxiliary/hashing.h"
+
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#define EVALUATION_CACHE_MAGIC 0x43455356 // "VSEC"
+#define EVALUATION_CACHE_VERSION 2
+
+template<typename T>
+void writeBinary(std::ostream &file, const T &value) {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readBinary(std::istream &file, T &value) {
+    file.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return file.gcount() == sizeof(T);
+}
+
+void writeEvaluation(std::ostream &file, const CachedEvaluation &entry) {
+    writeBinary(file, entry.pattern_hash);
+    writeBinary(file, entry.filling_method);
+    writeBinary(file, entry.collision_radius);
+    writeBinary(file, entry.repulsion);
+    writeBinary(file, entry.step_length);
+    writeBinary(file, entry.starting_point_separation);
+    writeBinary(file, entry.print_radius);
+    writeBinary(file, entry.repulsion_radius);
+    writeBinary(file, entry.repulsion_angle);
+    writeBinary(file, entry.seed);
+
+    const FillMetrics &metrics = entry.metrics;
+    writeBinary(file, metrics.empty_spots);
+    writeBinary(file, metrics.average_overlap);
+    writeBinary(file, metrics.average_director_disagreement);
+    writeBinary(file, metrics.average_angular_director_disagreement);
+    writeBinary(file, metrics.paths_number);
+    auto bucket_count = (uint32_t) metrics.director_disagreement_distribution.size();
+    writeBinary(file, bucket_count);
+    for (unsigned int bucket: metrics.director_disagreement_distribution) {
+        writeBinary(file, (uint32_t) bucket);
+    }
+}
+
+bool readEvaluation(std::istream &file, CachedEvaluation &entry) {
+    FillMetrics &metrics = entry.metrics;
+    uint32_t bucket_count = 0;
+    bool is_read = readBinary(file, entry.pattern_hash) &&
+                   readBinary(file, entry.filling_method) &&
+                   readBinary(file, entry.collision_radius) &&
+                   readBinary(file, entry.repulsion) &&
+                   readBinary(file, entry.step_length) &&
+                   readBinary(file, entry.starting_point_separation) &&
+                   readBinary(file, entry.print_radius) &&
+                   readBinary(file, entry.repulsion_radius) &&
+                   readBinary(file, entry.repulsion_angle) &&
+                   readBinary(file, entry.seed) &&
+                   readBinary(file, metrics.empty_spots) &&
+                   readBinary(file, metrics.average_overlap) &&
+                   readBinary(file, metrics.average_director_disagreement) &&
+                   readBinary(file, metrics.average_angular_director_disagreement) &&
+                   readBinary(file, metrics.paths_number) &&
+                   readBinary(file, bucket_count);
+    if (!is_read) {
+        return false;
+    }
+    metrics.director_disagreement_distribution.resize(bucket_count);
+    for (unsigned int &bucket: metrics.director_disagreement_distribution) {
+        uint32_t value;
+        if (!readBinary(file, value)) {
+            return false;
+        }
+        bucket = value;
+    }
+    return true;
+}
+
+
+CachedEvaluation::CachedEvaluation(uint64_t pattern_hash, const FillingConfig &config, FillMetrics metrics) :
+        pattern_hash(pattern_hash),
+        filling_method(config.getInitialSeedingMethod()),
+        collision_radius(config.getTerminationRadius()),
+        repulsion(config.getRepulsion()),
+        step_length(config.getStepLength()),
+        starting_point_separation(config.getSeedSpacing()),
+        print_radius(config.getPrintRadius()),
+        repulsion_radius(config.getRepulsionRadius()),
+        repulsion_angle(config.getRepulsionAngle()),
+        seed(config.getSeed()),
+        metrics(std::move(metrics)) {
+}
+
+uint64_t CachedEvaluation::getKey() const {
+    StableHash hash;
+    hash.add(getParametersKey());
+    hash.add(seed);
+    return hash.getHash();
+}
+
+uint64_t CachedEvaluation::getParametersKey() const {
+    StableHash hash;
+    hash.add(pattern_hash);
+    hash.add(filling_method);
+    hash.add(collision_radius);
+    hash.add(repulsion);
+    hash.add(step_length);
+    hash.add(starting_point_separation);
+    hash.add(print_radius);
+    hash.add(repulsion_radius);
+    hash.add(repulsion_angle);
+    return hash.getHash();
+}
+
+
+bool readCacheHeader(std::ifstream &file) {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    return readBinary(file, magic) && readBinary(file, version) && magic == EVALUATION_CACHE_MAGIC &&
+           version == EVALUATION_CACHE_VERSION;
+}
+
+std::vector<CachedEvaluation> readCachedEvaluations(const fs::path &cache_path) {
+    std::ifstream file(cache_path.string(), std::ios::binary);
+    if (!file.is_open() || !readCacheHeader(file)) {
+        throw std::runtime_error("Evaluation cache " + cache_path.string() + " is missing or has incompatible format.");
+    }
+    std::vector<CachedEvaluation> entries;
+    CachedEvaluation entry;
+    while (file.peek() != EOF && readEvaluation(file, entry)) {
+        entries.emplace_back(entry);
+    }
+    return entries;
+}
+
+
+EvaluationCache::EvaluationCache(fs::path cache_path, uint64_t pattern_hash) :
+        cache_path(std::move(cache_path)),
+        pattern_hash(pattern_hash) {
+    readCacheFile();
+}
+
+void EvaluationCache::readCacheFile() {
+    if (!fs::exists(cache_path)) {
+        writeCacheFile({}, false);
+        return;
+    }
+    std::ifstream file(cache_path.string(), std::ios::binary);
+    if (!readCacheHeader(file)) {
+        std::cout << "Evaluation cache " << cache_path << " has incompatible format and will be reset." << std::endl;
+        file.close();
+        writeCacheFile({}, false);
+        return;
+    }
+
+    bool is_rewrite_required = false;
+    CachedEvaluation entry;
+    while (file.peek() != EOF) {
+        if (!readEvaluation(file, entry)) {
+            is_rewrite_required = true;
+            break;
+        }
+        if (entry.pattern_hash == pattern_hash) {
+            evaluations[entry.getKey()] = entry;
+        } else {
+            is_rewrite_required = true;
+        }
+    }
+    file.close();
+
+    if (is_rewrite_required) {
+        // Drop entries of previous versions of the pattern and any record truncated by an interrupted run.
+        std::vector<CachedEvaluation> valid_entries;
+        valid_entries.reserve(evaluations.size());
+        for (auto &evaluation: evaluations) {
+            valid_entries.emplace_back(evaluation.second);
+        }
+        writeCacheFile(valid_entries, false);
+    }
+    std::cout << "Loaded " << evaluations.size() << " cached evaluations." << std::endl;
+}
+
+void EvaluationCache::writeCacheFile(const std::vector<CachedEvaluation> &entries, bool is_appended) const {
+    std::ofstream file;
+    if (is_appended) {
+        file.open(cache_path.string(), std::ios::binary | std::ios::app);
+    } else {
+        file.open(cache_path.string(), std::ios::binary | std::ios::trunc);
+        writeBinary(file, (uint32_t) EVALUATION_CACHE_MAGIC);
+        writeBinary(file, (uint32_t) EVALUATION_CACHE_VERSION);
+    }
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open evaluation cache " + cache_path.string() + " for writing.");
+    }
+    for (const CachedEvaluation &entry: entries) {
+        writeEvaluation(file, entry);
+    }
+    file.close();
+}
+
+bool EvaluationCache::find(const FillingConfig &config, FillMetrics &metrics) const {
+    uint64_t key = CachedEvaluation(pattern_hash, config, {}).getKey();
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto evaluation = evaluations.find(key);
+    if (evaluation == evaluations.end()) {
+        return false;
+    }
+    metrics = evaluation->second.metrics;
+    return true;
+}
+
+void EvaluationCache::insert(const FillingConfig &config, const FillMetrics &metrics) {
+    CachedEvaluation entry(pattern_hash, config, metrics);
+    uint64_t key = entry.getKey();
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (evaluations.emplace(key, entry).second) {
+        unsaved_evaluations.emplace_back(entry);
+    }
+}
+
+void EvaluationCache::save() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (unsaved_evaluations.empty()) {
+        return;
+    }
+    writeCacheFile(unsaved_evaluations, true);
+    unsaved_evaluations.clear();
+}
+
+std::vector<CachedEvaluation> EvaluationCache::getEvaluations() const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::vector<CachedEvaluation> entries;
+    entries.reserve(evaluations.size());
+    for (auto &evaluation: evaluations) {
+        entries.emplace_back(evaluation.second);
+    }
+    return entries;
+}
+
+size_t EvaluationCache::size() const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return evaluations.size();
+}
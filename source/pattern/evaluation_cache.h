@@ -0,0 +1,113 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 18/10/2026.
+//
+
+#ifndef VECTOR_SLICER_EVALUATION_CACHE_H
+#define VECTOR_SLICER_EVALUATION_CACHE_H
+
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+#include "filling_config.h"
+
+namespace fs = boost::filesystem;
+
+/// Raw metrics of a filled pattern. They do not depend on the disagreement weights, so they can be reused after the
+/// disagreement function is changed.
+struct FillMetrics {
+    double empty_spots = 0;
+    double average_overlap = 0;
+    double average_director_disagreement = 0;
+    double average_angular_director_disagreement = 0;
+    double paths_number = 0;
+    std::vector<unsigned int> director_disagreement_distribution;
+};
+
+/// Single cached evaluation: the generating parameters of the fill together with its metrics.
+struct CachedEvaluation {
+    uint64_t pattern_hash = 0;
+    int32_t filling_method = 0;
+    double collision_radius = 0;
+    double repulsion = 0;
+    int32_t step_length = 0;
+    double starting_point_separation = 0;
+    double print_radius = 0;
+    double repulsion_radius = 0;
+    double repulsion_angle = 0;
+    uint32_t seed = 0;
+    FillMetrics metrics;
+
+    CachedEvaluation() = default;
+
+    CachedEvaluation(uint64_t pattern_hash, const FillingConfig &config, FillMetrics metrics);
+
+    [[nodiscard]] uint64_t getKey() const;
+
+    /// Key of the generating parameters, shared by all seeds.
+    [[nodiscard]] uint64_t getParametersKey() const;
+};
+
+void writeEvaluation(std::ostream &file, const CachedEvaluation &entry);
+
+/// Reads a single evaluation from the stream. Returns false if the stream ends before the evaluation is complete.
+bool readEvaluation(std::istream &file, CachedEvaluation &entry);
+
+/// Reads all evaluations stored in the cache file, regardless of the pattern they belong to.
+std::vector<CachedEvaluation> readCachedEvaluations(const fs::path &cache_path);
+
+/// \brief On-disk cache of evaluations of a single pattern, keyed by the hash of the pattern inputs, filling method,
+/// generating parameters and seed. Entries are appended to the cache file, so repeated optimisations of an unchanged
+/// pattern do not need to fill it again. Thread-safe.
+class EvaluationCache {
+    fs::path cache_path;
+    uint64_t pattern_hash;
+    std::unordered_map<uint64_t, CachedEvaluation> evaluations;
+    std::vector<CachedEvaluation> unsaved_evaluations;
+    mutable std::mutex cache_mutex;
+
+    void readCacheFile();
+
+    void writeCacheFile(const std::vector<CachedEvaluation> &entries, bool is_appended) const;
+
+public:
+    EvaluationCache(fs::path cache_path, uint64_t pattern_hash);
+
+    /// Looks for the evaluation of the config. Returns true and fills the metrics if it was found.
+    bool find(const FillingConfig &config, FillMetrics &metrics) const;
+
+    void insert(const FillingConfig &config, const FillMetrics &metrics);
+
+    /// Appends evaluations inserted since the last save to the cache file.
+    void save();
+
+    [[nodiscard]] std::vector<CachedEvaluation> getEvaluations() const;
+
+    [[nodiscard]] size_t size() const;
+};
+
+
+#endif //VECTOR_SLICER_EVALUATION_CACHE_H
@@ -46,13 +46,26 @@ FilledPattern::FilledPattern(const DesiredPattern &new_desired_pattern, const Fi
         desired_pattern(std::cref(new_desired_pattern)),
         FillingConfig(new_config) {
     desired_pattern.get().isPatternUpdated();
+    // Paths reach every tile that contains a part of the shape, so tiles only save memory if some of them do not.
+    allocateFill(TiledGrid<uint8_t>::isEveryTileOccupied(desired_pattern.get().getShapeMatrix()));
+    setup();
+}
+
+
+void FilledPattern::allocateFill(bool is_dense) {
     int x_dim = desired_pattern.get().getDimensions()[0];
     int y_dim = desired_pattern.get().getDimensions()[1];
 
-    number_of_times_filled = std::vector<std::vector<uint8_t >>(x_dim, std::vector<uint8_t>(y_dim, 0));
-    x_field_filled = std::vector<std::vector<double >>(x_dim, std::vector<double>(y_dim, 0));
-    y_field_filled = std::vector<std::vector<double >>(x_dim, std::vector<double>(y_dim, 0));
-    setup();
+    number_of_times_filled = TiledGrid<uint8_t>(x_dim, y_dim, {0, 0}, is_dense);
+    x_field_filled = TiledGrid<double>(x_dim, y_dim, {0, 0}, is_dense);
+    y_field_filled = TiledGrid<double>(x_dim, y_dim, {0, 0}, is_dense);
+    sequence_of_paths.clear();
+    current_seed_line_index = 0;
+}
+
+
+void FilledPattern::clearFill() {
+    allocateFill(number_of_times_filled.isDense());
 }
 
 
@@ -96,6 +109,27 @@ void FilledPattern::setup() {
     print_circle = findPointsInDisk(getPrintRadius());
     collision_list = circleDisplacements(getTerminationRadius());
 
+    setupSeedLines();
+    setupRootPoints();
+    updateSeedPoints();
+}
+
+
+FilledPattern::FilledPattern(const DesiredPattern &desired_pattern, int print_radius, int collision_radius,
+                             int step_length, unsigned int seed) :
+        FilledPattern::FilledPattern(desired_pattern,
+                                     FillingConfig(Perimeter, collision_radius, 2 * print_radius, 1.0, step_length,
+                                                   print_radius,
+                                                   0, seed)) {
+}
+
+
+FilledPattern::FilledPattern(const DesiredPattern &desired_pattern, int print_radius, int collision_radius,
+                             int step_length) :
+        FilledPattern::FilledPattern(desired_pattern, print_radius, collision_radius, step_length, 0) {}
+
+
+void FilledPattern::setupSeedLines() {
     switch (getInitialSeedingMethod()) {
         case Splay:
             if (desired_pattern.get().isSplayProvided()) {
@@ -115,23 +149,123 @@ void FilledPattern::setup() {
             search_stage = RemainingFilling;
             break;
     }
-    setupRootPoints();
-    updateSeedPoints();
 }
 
 
-FilledPattern::FilledPattern(const DesiredPattern &desired_pattern, int print_radius, int collision_radius,
-                             int step_length, unsigned int seed) :
-        FilledPattern::FilledPattern(desired_pattern,
-                                     FillingConfig(Perimeter, collision_radius, 2 * print_radius, 1.0, step_length,
-                                                   print_radius,
-                                                   0, seed)) {
+FilledPattern::FilledPattern(const FilledPattern &pattern, unsigned int island, const Island &window) :
+        FillingConfig(pattern),
+        search_stage(pattern.search_stage),
+        print_circle(pattern.print_circle),
+        collision_list(pattern.collision_list),
+        is_reseeding_enabled(pattern.is_reseeding_enabled),
+        is_random_filling_enabled(pattern.is_random_filling_enabled),
+        x_field_filled(window.maximum.x - window.minimum.x + 1, window.maximum.y - window.minimum.y + 1,
+                       window.minimum),
+        y_field_filled(window.maximum.x - window.minimum.x + 1, window.maximum.y - window.minimum.y + 1,
+                       window.minimum),
+        desired_pattern(pattern.desired_pattern),
+        number_of_times_filled(window.maximum.x - window.minimum.x + 1, window.maximum.y - window.minimum.y + 1,
+                               window.minimum) {
+    std::seed_seq island_seed = {getSeed(), island};
+    random_engine.seed(island_seed);
 }
 
 
-FilledPattern::FilledPattern(const DesiredPattern &desired_pattern, int print_radius, int collision_radius,
-                             int step_length) :
-        FilledPattern::FilledPattern(desired_pattern, print_radius, collision_radius, step_length, 0) {}
+int FilledPattern::islandSeparation() const {
+    // Paths fill up to the print radius away from the island, and look for filled points up to the termination
+    // radius and, when repelled, up to twice the print radius away from their own island.
+    return (int) ceil(3 * getPrintRadius() + getTerminationRadius()) + getStepLength() + 2;
+}
+
+
+int findIslandGroup(const std::vector<coord> &line, const IslandMap &island_map, const std::vector<int> &groups) {
+    for (const coord &point: line) {
+        uint16_t label = island_map.labels.get(point);
+        if (label != 0) {
+            return groups[label - 1];
+        }
+    }
+    return -1;
+}
+
+
+/// Bounding box of the island enlarged by the separation, limited to the pattern
+Island islandReach(const Island &island, int separation, const coord &last_point) {
+    return {coord(std::max(0, island.minimum.x - separation), std::max(0, island.minimum.y - separation)),
+            coord(std::min((int) last_point.x, island.maximum.x + separation),
+                  std::min((int) last_point.y, island.maximum.y + separation))};
+}
+
+
+std::vector<FilledPattern> FilledPattern::splitIntoIslands() {
+    const IslandMap &island_map = desired_pattern.get().getIslandMap();
+    std::vector<int> groups = groupIslands(island_map.islands, islandSeparation());
+    int group_count = groups.empty() ? 0 : *std::max_element(groups.begin(), groups.end()) + 1;
+    if (group_count <= 1) {
+        return {};
+    }
+
+    // Each group is filled on a window of the pattern reaching the separation beyond its islands, as its paths cannot
+    // reach further.
+    int separation = islandSeparation();
+    coord last_point = {number_of_times_filled.getRows() - 1, number_of_times_filled.getColumns() - 1};
+    std::vector<Island> windows(group_count, {last_point, {0, 0}});
+    for (int i = 0; i < island_map.islands.size(); i++) {
+        Island reach = islandReach(island_map.islands[i], separation, last_point);
+        Island &window = windows[groups[i]];
+        window.minimum = {std::min(window.minimum.x, reach.minimum.x), std::min(window.minimum.y, reach.minimum.y)};
+        window.maximum = {std::max(window.maximum.x, reach.maximum.x), std::max(window.maximum.y, reach.maximum.y)};
+    }
+
+    std::vector<FilledPattern> islands;
+    islands.reserve(group_count);
+    for (int group = 0; group < group_count; group++) {
+        islands.push_back(FilledPattern(*this, group, windows[group]));
+    }
+
+    setupSeedLines();
+    for (std::vector<coord> &line: seed_lines) {
+        int group = findIslandGroup(line, island_map, groups);
+        if (group != -1) {
+            islands[group].seed_lines.push_back(std::move(line));
+        }
+    }
+    seed_lines.clear();
+    seed_points.clear();
+    current_seed_line_index = 0;
+
+    for (FilledPattern &island: islands) {
+        island.binned_root_points.resize(binned_root_points.size());
+    }
+    for (int bin = 0; bin < binned_root_points.size(); bin++) {
+        for (const coord &point: binned_root_points[bin]) {
+            uint16_t label = island_map.labels.get(point);
+            if (label != 0) {
+                islands[groups[label - 1]].binned_root_points[bin].push_back(point);
+            }
+        }
+    }
+
+    for (FilledPattern &island: islands) {
+        island.updateSeedPoints();
+    }
+    return islands;
+}
+
+
+void FilledPattern::mergeIslands(std::vector<FilledPattern> &islands) {
+    for (FilledPattern &island: islands) {
+        number_of_times_filled.add(island.number_of_times_filled);
+        x_field_filled.add(island.x_field_filled);
+        y_field_filled.add(island.y_field_filled);
+        // Seed lines of each island are numbered from 0, so they are shifted past the lines of the previous islands.
+        for (Path &path: island.sequence_of_paths) {
+            path.setSeedLine(path.getSeedPoint().getSeedLine() + current_seed_line_index);
+            sequence_of_paths.push_back(std::move(path));
+        }
+        current_seed_line_index += island.current_seed_line_index;
+    }
+}
 
 
 /**
@@ -143,7 +277,7 @@ void FilledPattern::setupRootPoints() {
     if (root_points.empty()) {
         return;
     }
-#pragma omp parallel for
+    // The bins are shuffled in order through the single random engine, so that the root points only depend on the seed.
     for (auto &bin: root_points) {
         if (!bin.empty()) {
             std::shuffle(bin.begin(), bin.end(), random_engine);
@@ -259,23 +393,24 @@ coord FilledPattern::findRemainingRootPoint() {
 }
 
 void FilledPattern::fillPoint(const coord &point, const coord_d &normalized_direction, int value) {
-    if (isInRange(point) && number_of_times_filled[point.x][point.y] + value >= 0) {
-        number_of_times_filled[point.x][point.y] += value;
+    if (number_of_times_filled.contains(point) && number_of_times_filled.get(point) + value >= 0) {
+        number_of_times_filled.getReference(point) += value;
+        double &x_filled = x_field_filled.getReference(point);
+        double &y_filled = y_field_filled.getReference(point);
 
-        if (normalized_direction.x * x_field_filled[point.x][point.y] +
-            normalized_direction.y * y_field_filled[point.x][point.y] < 0) {
+        if (normalized_direction.x * x_filled + normalized_direction.y * y_filled < 0) {
             value *= -1;
         }
-        x_field_filled[point.x][point.y] += normalized_direction.x * value;
-        y_field_filled[point.x][point.y] += normalized_direction.y * value;
+        x_filled += normalized_direction.x * value;
+        y_filled += normalized_direction.y * value;
     }
 }
 
 void FilledPattern::fillPointNonAligned(const coord &point, const coord_d &normalized_direction, int value) {
-    if (isInRange(point) && number_of_times_filled[point.x][point.y] + value >= 0) {
-        number_of_times_filled[point.x][point.y] += value;
-        x_field_filled[point.x][point.y] += normalized_direction.x * value;
-        y_field_filled[point.x][point.y] += normalized_direction.y * value;
+    if (number_of_times_filled.contains(point) && number_of_times_filled.get(point) + value >= 0) {
+        number_of_times_filled.getReference(point) += value;
+        x_field_filled.getReference(point) += normalized_direction.x * value;
+        y_field_filled.getReference(point) += normalized_direction.y * value;
     }
 }
 
@@ -493,7 +628,7 @@ double FilledPattern::getOverlap(const std::vector<coord> &points_to_check) {
     int overlap = 0;
     for (auto &point: points_to_check) {
         if (isInRange(point)) {
-            overlap += number_of_times_filled[point.x][point.y] - 1;
+            overlap += number_of_times_filled.get(point) - 1;
         }
     }
     if (points_count == 0) {
@@ -637,7 +772,7 @@ FilledPattern::fillPointsInHalfCircle(const Path &path, int value, bool is_front
 
 
 void FilledPattern::exportFilledMatrix(const fs::path &path) const {
-    exportVectorTableToFile(number_of_times_filled, path);
+    exportVectorTableToFile(number_of_times_filled.toTable(), path);
 }
 
 
@@ -646,6 +781,16 @@ std::vector<Path> FilledPattern::getSequenceOfPaths() const {
 }
 
 
+size_t FilledPattern::getAllocatedBytes() const {
+    size_t allocated_bytes = number_of_times_filled.getAllocatedBytes() + x_field_filled.getAllocatedBytes() +
+                             y_field_filled.getAllocatedBytes() + sequence_of_paths.capacity() * sizeof(Path);
+    for (const Path &path: sequence_of_paths) {
+        allocated_bytes += path.getAllocatedBytes();
+    }
+    return allocated_bytes;
+}
+
+
 void FilledPattern::addNewPath(Path &new_path) {
     sequence_of_paths.push_back(new_path);
 }
@@ -754,7 +899,7 @@ FilledPattern::getSpacedLine(const std::vector<coord> &line, int line_index, int
 
 /// Tests if the coordinate is within the pattern and unfilled.
 bool FilledPattern::isFillable(const coord &coordinate) const {
-    return desired_pattern.get().isInShape(coordinate) && number_of_times_filled[coordinate.x][coordinate.y] == 0;
+    return desired_pattern.get().isInShape(coordinate) && number_of_times_filled.get(coordinate) == 0;
 }
 
 /// Tests if the coordinate is within the pattern and unfilled.
@@ -763,7 +908,7 @@ bool FilledPattern::isFillable(const coord_d &coordinate) const {
 }
 
 bool FilledPattern::isFilled(const coord &coordinate) const {
-    return isInRange(coordinate) && number_of_times_filled[coordinate.x][coordinate.y];
+    return isInRange(coordinate) && number_of_times_filled.get(coordinate);
 }
 
 
@@ -32,6 +32,7 @@
 #include "filling_config.h"
 #include "auxiliary/valarray_operations.h"
 #include "seed_point.h"
+#include "tiled_grid.h"
 
 using vecd = std::vector<double>;
 
@@ -66,6 +67,9 @@ class FilledPattern : public FillingConfig {
     /// Switches whether seeds from seed line are taken at random or consecutively. Default: true
     bool is_random_filling_enabled = true;
 
+    /// Replaces the filled fields with empty ones, stored densely or in tiles, and removes the paths
+    void allocateFill(bool is_dense);
+
     void fillPoint(const coord &point, const coord_d &normalized_direction, int value);
 
     void fillPointsFromList(const std::vector<coord> &points_to_fill, const coord_d &direction, int value);
@@ -141,6 +145,16 @@ class FilledPattern : public FillingConfig {
 
     void extendSeedLines();
 
+    /// Selects the seed lines of the initial seeding method
+    void setupSeedLines();
+
+    /// Pattern filling one of the islands of the pattern within a window of the fields, without any seed lines or root
+    /// points
+    FilledPattern(const FilledPattern &pattern, unsigned int island, const Island &window);
+
+    /// Distance between islands beyond which the paths filling one of them cannot affect the other
+    [[nodiscard]] int islandSeparation() const;
+
     coord_d
     normalisedResultant(const coord_d &primary_vector, const coord_d &secondary_vector, bool is_discontinuity_detected);
 
@@ -150,13 +164,15 @@ class FilledPattern : public FillingConfig {
 
 public:
 
-    std::vector<std::vector<double>> x_field_filled;
+    /// Fill state is kept in tiles that are allocated once a path reaches them, so that the empty areas of the
+    /// pattern do not take up memory for every seed.
+    TiledGrid<double> x_field_filled;
 
-    std::vector<std::vector<double>> y_field_filled;
+    TiledGrid<double> y_field_filled;
 
     std::reference_wrapper<const DesiredPattern> desired_pattern;
 
-    std::vector<std::vector<uint8_t>> number_of_times_filled;
+    TiledGrid<uint8_t> number_of_times_filled;
 
     FilledPattern(const DesiredPattern &desired_pattern, int print_radius, int collision_radius, int step_length,
                   unsigned int seed);
@@ -168,6 +184,9 @@ public:
     /// Sets up the objects deriving from the FillingConfig
     void setup();
 
+    /// Empties the filled fields and removes the paths, so that the pattern can be filled anew
+    void clearFill();
+
     /// Postprocessing: removes paths shorter than the set threshold
     void removeShortLines(double length_coefficient);
 
@@ -187,6 +206,9 @@ public:
 
     [[nodiscard]] std::vector<Path> getSequenceOfPaths() const;
 
+    /// Memory taken by the filled fields and the paths in bytes
+    [[nodiscard]] size_t getAllocatedBytes() const;
+
     void exportFilledMatrix(const fs::path &path) const;
 
     /// Updates overlaps in Paths for postprocessing.
@@ -204,6 +226,13 @@ public:
     void fillPointNonAligned(const coord &point, const coord_d &normalized_direction, int value);
 
     bool isFilled(const coord &coordinate) const;
+
+    /// Splits the pattern into the groups of islands which are far enough apart not to interact, and sets up a pattern
+    /// filling each of them. Returns no patterns if the pattern cannot be split.
+    std::vector<FilledPattern> splitIntoIslands();
+
+    /// Combines the paths and the filled fields of the filled islands into the pattern
+    void mergeIslands(std::vector<FilledPattern> &islands);
 };
 
 
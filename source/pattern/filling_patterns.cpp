@@ -46,7 +46,7 @@ bool tryGeneratingNewPath(FilledPattern &pattern) {
     }
 }
 
-void fillWithPaths(FilledPattern &pattern) {
+void fillIsland(FilledPattern &pattern) {
     bool is_there_any_spot_fillable = true;
     while (is_there_any_spot_fillable) {
         is_there_any_spot_fillable = tryGeneratingNewPath(pattern);
@@ -58,4 +58,17 @@ void fillWithPaths(FilledPattern &pattern) {
     if (short_line_coefficient > 0) {
         pattern.removeShortLines(short_line_coefficient);
     }
+}
+
+void fillWithPaths(FilledPattern &pattern, int threads) {
+    std::vector<FilledPattern> islands = pattern.splitIntoIslands();
+    if (islands.empty()) {
+        fillIsland(pattern);
+        return;
+    }
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+    for (int i = 0; i < islands.size(); i++) {
+        fillIsland(islands[i]);
+    }
+    pattern.mergeIslands(islands);
 }
\ No newline at end of file
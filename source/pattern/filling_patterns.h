@@ -29,6 +29,8 @@
 
 bool tryGeneratingNewPath(FilledPattern &pattern);
 
-void fillWithPaths(FilledPattern &pattern);
+/// Fills the pattern with paths. Groups of islands that are too far apart to interact are filled in parallel by the
+/// threads, which only take effect if nested parallelism is enabled when the pattern is filled in a parallel region.
+void fillWithPaths(FilledPattern &pattern, int threads);
 
 #endif //VECTOR_SLICER_FILLING_PATTERNS_H
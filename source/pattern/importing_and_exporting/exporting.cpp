@@ -150,6 +150,9 @@ std::string generateHeader(const std::string &pattern_name, double print_diamete
              << "# Creation date: " << time << std::endl
              << "# Source directory: " << pattern_name << std::endl
              << "# Print diameter: " << print_diameter << std::endl;
+    if (simulation.getTunedThreads() > 0) {
+        header_s << "# Threads tuned automatically: " << simulation.getTunedThreads() << std::endl;
+    }
     header_s << std::endl;
 
     header_s << "# Disagreement configuration:" << std::endl
@@ -23,6 +23,7 @@
 //
 
 #include "open_files.h"
+#include "pattern_snapshot.h"
 #include <iostream>
 #include <sstream>
 
@@ -81,6 +82,25 @@ openPatternFromDirectory(const fs::path &directory_path, int threads, const Fill
     return pattern;
 }
 
+DesiredPattern
+openPatternFromDirectory(const fs::path &directory_path, int threads, const FillingMethodConfig &filling,
+                         fillingMethod seeding_method, const fs::path &snapshot_path) {
+    uint64_t key = patternSnapshotKey(directory_path, filling);
+    DesiredPattern pattern;
+    bool is_snapshot_read = readPatternSnapshot(snapshot_path, key, threads, pattern);
+    if (is_snapshot_read) {
+        std::cout << "Prepared pattern loaded from snapshot. Pattern dimensions: " << pattern.getDimensions()[0] << "x"
+                  << pattern.getDimensions()[1] << std::endl;
+    } else {
+        pattern = openPatternFromDirectory(directory_path, threads, filling);
+    }
+    bool is_prepared = pattern.prepareSeeding(seeding_method);
+    if (!is_snapshot_read || is_prepared) {
+        writePatternSnapshot(snapshot_path, key, pattern);
+    }
+    return pattern;
+}
+
 
 FilledPattern
 openFilledPatternFromDirectoryAndPattern(const fs::path &directory_path, const DesiredPattern &pattern,
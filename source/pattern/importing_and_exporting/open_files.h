@@ -37,6 +37,13 @@ namespace fs = boost::filesystem;
 DesiredPattern
 openPatternFromDirectory(const fs::path &directory_path, int threads, const FillingMethodConfig &filling);
 
+/// Loads the prepared pattern from the snapshot if its inputs and filling method options have not changed since it was
+/// saved. Otherwise the pattern is prepared from the directory. The structures used by the seeding method are
+/// calculated if the snapshot does not contain them, in which case the snapshot is replaced.
+DesiredPattern
+openPatternFromDirectory(const fs::path &directory_path, int threads, const FillingMethodConfig &filling,
+                         fillingMethod seeding_method, const fs::path &snapshot_path);
+
 FilledPattern openFilledPatternFromDirectory(const fs::path &directory_path, int threads);
 
 FilledPattern openFilledPatternFromDirectory(const fs::path &directory_path, unsigned int seed, int threads);
@@ -0,0 +1,156 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 19/10/2026.
+//
+
+#include "pattern_snapshot.h"
+#include "../desired_pattern.h"
+#include "../auxiliary/hashing.h"
+#include "../simulation/filling_method_config.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "vector_slicer_config.h"
+
+#define PATTERN_SNAPSHOT_MAGIC 0x53505356 // "VSPS"
+#define PATTERN_SNAPSHOT_VERSION 4
+#define PATTERN_SNAPSHOT_HASH_CHUNK (1 << 16)
+
+
+SnapshotWriter::SnapshotWriter(std::ostream &file) : file(file) {}
+
+
+SnapshotReader::SnapshotReader(const char *data, size_t size) : position(data), end(data + size) {}
+
+bool SnapshotReader::isAvailable(uint64_t size) {
+    if (!is_valid || size > (uint64_t) (end - position)) {
+        is_valid = false;
+    }
+    return is_valid;
+}
+
+bool SnapshotReader::isComplete() const {
+    return is_valid && position == end;
+}
+
+
+uint64_t patternSnapshotKey(const fs::path &directory_path, const FillingMethodConfig &filling) {
+    StableHash hash;
+    hash.add(std::string(SLICER_VER));
+    hash.add((uint32_t) PATTERN_SNAPSHOT_VERSION);
+    std::vector<char> buffer(PATTERN_SNAPSHOT_HASH_CHUNK);
+    for (const char *filename: {"shape.csv", "theta_field.csv", "xField.csv", "yField.csv", "splay.csv"}) {
+        fs::path input_path = directory_path / filename;
+        bool is_present = fs::exists(input_path);
+        hash.add(is_present);
+        if (is_present) {
+            // Hashed in chunks with the size in front, as a string of the whole file would be.
+            hash.add((size_t) fs::file_size(input_path));
+            std::ifstream file(input_path.string(), std::ios::binary);
+            while (file.read(buffer.data(), (std::streamsize) buffer.size()) || file.gcount() > 0) {
+                hash.add(buffer.data(), (size_t) file.gcount());
+            }
+        }
+    }
+    hash.add(filling.isVectorFillingEnabled());
+    hash.add(filling.isVectorSortingEnabled());
+    hash.add(filling.isPointsRemoved());
+    hash.add(filling.getMinimalLineLength());
+    hash.add(filling.getDiscontinuityThreshold());
+    hash.add(filling.getDiscontinuityBehaviour());
+    hash.add(filling.getSortingMethod());
+    hash.add(filling.getSplayLineBehaviour());
+    return hash.getHash();
+}
+
+
+bool readPatternSnapshot(const fs::path &snapshot_path, uint64_t key, int threads, DesiredPattern &pattern) {
+    if (!fs::exists(snapshot_path) || fs::file_size(snapshot_path) == 0) {
+        return false;
+    }
+    namespace ipc = boost::interprocess;
+    try {
+        ipc::file_mapping mapping(snapshot_path.string().c_str(), ipc::read_only);
+        ipc::mapped_region region(mapping, ipc::read_only);
+        SnapshotReader reader(static_cast<const char *>(region.get_address()), region.get_size());
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint64_t snapshot_key = 0;
+        uint64_t content_hash = 0;
+        reader.read(magic);
+        reader.read(version);
+        reader.read(snapshot_key);
+        reader.read(content_hash);
+        if (magic != PATTERN_SNAPSHOT_MAGIC || version != PATTERN_SNAPSHOT_VERSION || snapshot_key != key) {
+            return false;
+        }
+        DesiredPattern snapshot_pattern;
+        snapshot_pattern.readSnapshot(reader, threads);
+        if (!reader.isComplete()) {
+            std::cout << "Pattern snapshot " << snapshot_path << " is truncated and will be recalculated." << std::endl;
+            return false;
+        }
+        pattern = std::move(snapshot_pattern);
+    } catch (const ipc::interprocess_exception &exception) {
+        std::cout << "Unable to map pattern snapshot " << snapshot_path << ": " << exception.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+bool readPatternSnapshotContentHash(const fs::path &snapshot_path, uint64_t key, uint64_t &content_hash) {
+    std::ifstream file(snapshot_path.string(), std::ios::binary);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t snapshot_key = 0;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char *>(&version), sizeof(version));
+    file.read(reinterpret_cast<char *>(&snapshot_key), sizeof(snapshot_key));
+    file.read(reinterpret_cast<char *>(&content_hash), sizeof(content_hash));
+    return file && magic == PATTERN_SNAPSHOT_MAGIC && version == PATTERN_SNAPSHOT_VERSION && snapshot_key == key;
+}
+
+
+void writePatternSnapshot(const fs::path &snapshot_path, uint64_t key, const DesiredPattern &pattern) {
+    fs::path temporary_path = snapshot_path;
+    temporary_path += ".tmp";
+    std::ofstream file(temporary_path.string(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open pattern snapshot " + temporary_path.string() + " for writing.");
+    }
+    SnapshotWriter writer(file);
+    writer.write((uint32_t) PATTERN_SNAPSHOT_MAGIC);
+    writer.write((uint32_t) PATTERN_SNAPSHOT_VERSION);
+    writer.write(key);
+    writer.write(pattern.getContentHash());
+    pattern.writeSnapshot(writer);
+    file.close();
+    // Renaming makes sure that an interrupted run does not leave a partially written snapshot in place.
+    fs::rename(temporary_path, snapshot_path);
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 19/10/2026.
+//
+
+#ifndef VECTOR_SLICER_PATTERN_SNAPSHOT_H
+#define VECTOR_SLICER_PATTERN_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+#include "../auxiliary/lazy.h"
+
+namespace fs = boost::filesystem;
+
+class DesiredPattern;
+
+class FillingMethodConfig;
+
+/// Writes the fields of a prepared pattern into a binary snapshot.
+class SnapshotWriter {
+    std::ostream &file;
+
+public:
+    explicit SnapshotWriter(std::ostream &file);
+
+    template<typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written directly.");
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void write(const std::vector<T> &values) {
+        write((uint64_t) values.size());
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            file.write(reinterpret_cast<const char *>(values.data()), (std::streamsize) (values.size() * sizeof(T)));
+        } else {
+            for (const T &value: values) {
+                write(value);
+            }
+        }
+    }
+
+    /// Writes whether the value was calculated, followed by the value if it was
+    template<typename T>
+    void write(const Lazy<T> &lazy_value) {
+        const T *value = lazy_value.peek();
+        write(value != nullptr);
+        if (value != nullptr) {
+            write(*value);
+        }
+    }
+};
+
+/// Reads the fields of a prepared pattern from a memory-mapped snapshot. Reading past the end of the snapshot marks it
+/// as invalid instead of throwing, so that a truncated snapshot can be recalculated.
+class SnapshotReader {
+    const char *position;
+    const char *end;
+    bool is_valid = true;
+
+    bool isAvailable(uint64_t size);
+
+public:
+    SnapshotReader(const char *data, size_t size);
+
+    template<typename T>
+    void read(T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read directly.");
+        if (!isAvailable(sizeof(T))) {
+            return;
+        }
+        std::memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+    }
+
+    template<typename T>
+    void read(std::vector<T> &values) {
+        uint64_t size = 0;
+        read(size);
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (!is_valid || size > (uint64_t) (end - position) / sizeof(T)) {
+                is_valid = false;
+                return;
+            }
+            values.resize(size);
+            std::memcpy(values.data(), position, size * sizeof(T));
+            position += size * sizeof(T);
+        } else {
+            if (!is_valid || size > (uint64_t) (end - position) / sizeof(uint64_t)) {
+                is_valid = false;
+                return;
+            }
+            values.resize(size);
+            for (T &value: values) {
+                read(value);
+            }
+        }
+    }
+
+    template<typename T>
+    void read(Lazy<T> &lazy_value) {
+        bool is_calculated = false;
+        read(is_calculated);
+        if (is_valid && is_calculated) {
+            T value;
+            read(value);
+            lazy_value.set(std::move(value));
+        }
+    }
+
+    /// Whether all the reads so far were within the snapshot and the whole of it was read
+    [[nodiscard]] bool isComplete() const;
+};
+
+/// Key of the prepared pattern: hash of the contents of the input files of the directory, the filling method options
+/// and the version of the slicer.
+uint64_t patternSnapshotKey(const fs::path &directory_path, const FillingMethodConfig &filling);
+
+/// Reads the snapshot of the prepared pattern if it exists and was created with the same key. Returns false otherwise.
+/// Structures of the pattern that were not calculated when the snapshot was saved are calculated on their first use.
+bool readPatternSnapshot(const fs::path &snapshot_path, uint64_t key, int threads, DesiredPattern &pattern);
+
+/// Reads only the content hash of the pattern stored in the header of the snapshot, if the snapshot was created with the
+/// same key. Returns false otherwise.
+bool readPatternSnapshotContentHash(const fs::path &snapshot_path, uint64_t key, uint64_t &content_hash);
+
+/// Saves the prepared pattern, replacing any previous snapshot.
+void writePatternSnapshot(const fs::path &snapshot_path, uint64_t key, const DesiredPattern &pattern);
+
+#endif //VECTOR_SLICER_PATTERN_SNAPSHOT_H
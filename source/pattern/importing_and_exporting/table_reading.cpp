@@ -24,74 +24,217 @@
 
 #include "table_reading.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <exception>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <omp.h>
 
+namespace ipc = boost::interprocess;
 
-std::vector<std::vector<double>> readFileToTableDouble(const std::string &filename) {
-    std::string line;
-    std::ifstream file(filename);
-    if (file.fail()) {
-        std::cout << "File \"" << filename << "\" does not exist!" << std::endl;
-    }
-    std::vector<std::vector<double>> table;
+/// Lines of a memory-mapped text file, split the same way as by std::getline
+class MappedLines {
+    ipc::file_mapping mapping;
+    ipc::mapped_region region;
+    std::vector<std::string_view> lines;
 
-    while (std::getline(file, line)) {
-        std::string element;
-        std::stringstream line_stream(line);
-        std::vector<double> row;
-
-        while (std::getline(line_stream, element, ',')) {
-            if (element == "#") {
+public:
+    explicit MappedLines(const std::string &filename) {
+        if (!boost::filesystem::exists(filename)) {
+            std::cout << "File \"" << filename << "\" does not exist!" << std::endl;
+            return;
+        }
+        if (boost::filesystem::file_size(filename) == 0) {
+            return;
+        }
+        try {
+            mapping = ipc::file_mapping(filename.c_str(), ipc::read_only);
+            region = ipc::mapped_region(mapping, ipc::read_only);
+        } catch (const ipc::interprocess_exception &exception) {
+            std::cout << "Unable to map file \"" << filename << "\": " << exception.what() << std::endl;
+            return;
+        }
+        const char *begin = static_cast<const char *>(region.get_address());
+        const char *end = begin + region.get_size();
+        while (begin != end) {
+            const char *line_end = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+            if (line_end == nullptr) {
+                lines.emplace_back(begin, end - begin);
                 break;
             }
-            try {
-                row.push_back(std::stod(element));
-            }
-            catch (std::invalid_argument) {
-                std::cout << "Invalid element in imported double table: " << element << " in " << filename << std::endl;
-                throw;
-            }
+            lines.emplace_back(begin, line_end - begin);
+            begin = line_end + 1;
         }
-        table.push_back(row);
     }
-    return table;
-}
 
-std::vector<std::vector<coord_d>> readFileToTableDoubleVector(const std::string &filename) {
+    [[nodiscard]] size_t size() const {
+        return lines.size();
+    }
 
-    std::vector<std::vector<double>> table = readFileToTableDouble(filename);
+    [[nodiscard]] std::string_view operator[](size_t i) const {
+        return lines[i];
+    }
+};
 
-    std::vector<std::vector<coord_d>> vector_table;
-    for (auto &row: table) {
-        std::vector<coord_d> vector_row;
-        for (int i = 0; i < row.size(); i += 2) {
-            vector_row.emplace_back(coord_d{row[i], row[i + 1]});
+/// Calls parse_line(i, line) for each line, with the threads parsing blocks of consecutive lines in parallel. The first
+/// exception thrown while parsing is rethrown once all the lines are processed.
+template<typename LineParser>
+void parseLines(const MappedLines &lines, int threads, LineParser &&parse_line) {
+    std::exception_ptr exception;
+    omp_set_num_threads(threads);
+#pragma omp parallel for schedule(static)
+    for (long i = 0; i < (long) lines.size(); i++) {
+        try {
+            parse_line(i, lines[i]);
+        } catch (...) {
+#pragma omp critical(table_reading_exception)
+            if (!exception) {
+                exception = std::current_exception();
+            }
         }
-        vector_table.emplace_back(vector_row);
     }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
 
-    return vector_table;
+size_t countElements(std::string_view line) {
+    return std::count(line.begin(), line.end(), ',') + 1;
 }
 
-std::vector<std::vector<uint8_t>> tableDoubleToInt(std::vector<std::vector<double>> &double_table) {
-    std::vector<std::vector<uint8_t>> int_table;
-    for (auto &row: double_table) {
-        std::vector<uint8_t> int_row;
-        int_row.reserve(row.size());
-        for (auto &element: row) {
-            int_row.push_back((uint8_t) element);
+/// Calls parse_element for each comma-separated element of the line, up to the "#" element. The type of the table is
+/// only used to report invalid elements.
+template<typename ElementParser>
+void forEachElement(std::string_view line, const std::string &filename, const char *table_type,
+                    ElementParser &&parse_element) {
+    size_t element_start = 0;
+    while (element_start < line.size()) {
+        size_t element_end = std::min(line.find(',', element_start), line.size());
+        std::string_view element = line.substr(element_start, element_end - element_start);
+        if (element == "#") {
+            return;
+        }
+        try {
+            parse_element(element);
         }
-        int_table.push_back(int_row);
+        catch (const std::invalid_argument &) {
+#pragma omp critical(table_reading_message)
+            std::cout << "Invalid element in imported " << table_type << " table: " << element << " in " << filename
+                      << std::endl;
+            throw;
+        }
+        element_start = element_end + 1;
+    }
+}
+
+bool isSpace(char character) {
+    return character == ' ' || character == '\t' || character == '\r' || character == '\n' || character == '\v' ||
+           character == '\f';
+}
+
+/// Parses the element to the same value as std::stod. Elements that std::from_chars does not fully parse, such as ones
+/// with a leading plus or in hexadecimal, are passed to std::stod, as are all elements where the standard library does
+/// not provide std::from_chars for floating point numbers, such as libc++ of Apple clang.
+double parseDouble(std::string_view element) {
+#ifdef __cpp_lib_to_chars
+    const char *first = element.data();
+    const char *last = first + element.size();
+    while (first != last && isSpace(*first)) {
+        first++;
+    }
+    double value;
+    auto [end, error] = std::from_chars(first, last, value);
+    if (error == std::errc() && std::all_of(end, last, isSpace)) {
+        return value;
+    }
+#endif
+    return std::stod(std::string(element));
+}
+
+/// Parses the element to the same value as casting std::stod to uint8_t, reading plain integers directly
+uint8_t parseUint8(std::string_view element) {
+    const char *first = element.data();
+    const char *last = first + element.size();
+    while (first != last && isSpace(*first)) {
+        first++;
+    }
+    int value;
+    auto [end, error] = std::from_chars(first, last, value);
+    if (error == std::errc() && value >= 0 && value <= UINT8_MAX && std::all_of(end, last, isSpace)) {
+        return (uint8_t) value;
     }
-    return int_table;
+    return (uint8_t) parseDouble(element);
 }
 
 
-std::vector<std::vector<uint8_t>> readFileToTableInt(const std::string &filename) {
-    std::vector<std::vector<double>> double_table = readFileToTableDouble(filename);
-    return (tableDoubleToInt(double_table));
+std::vector<std::vector<double>> readFileToTableDouble(const std::string &filename, int threads) {
+    MappedLines lines(filename);
+    std::vector<std::vector<double>> table(lines.size());
+    parseLines(lines, threads, [&](size_t i, std::string_view line) {
+        table[i].reserve(countElements(line));
+        forEachElement(line, filename, "double", [&](std::string_view element) {
+            table[i].push_back(parseDouble(element));
+        });
+    });
+    return table;
+}
+
+std::vector<std::vector<coord_d>> readFileToTableDoubleVector(const std::string &filename, int threads) {
+    MappedLines lines(filename);
+    std::vector<std::vector<coord_d>> vector_table(lines.size());
+    parseLines(lines, threads, [&](size_t i, std::string_view line) {
+        std::vector<coord_d> &vector_row = vector_table[i];
+        vector_row.reserve(countElements(line) / 2);
+        bool is_x_read = false;
+        double x = 0;
+        forEachElement(line, filename, "vector", [&](std::string_view element) {
+            double value = parseDouble(element);
+            if (is_x_read) {
+                vector_row.emplace_back(x, value);
+            } else {
+                x = value;
+            }
+            is_x_read = !is_x_read;
+        });
+    });
+    return vector_table;
+}
+
+void readFileToDirectorTables(const std::string &theta_filename, std::vector<std::vector<double>> &x_field,
+                              std::vector<std::vector<double>> &y_field, int threads) {
+    MappedLines lines(theta_filename);
+    x_field.assign(lines.size(), {});
+    y_field.assign(lines.size(), {});
+    parseLines(lines, threads, [&](size_t i, std::string_view line) {
+        x_field[i].reserve(countElements(line));
+        y_field[i].reserve(countElements(line));
+        forEachElement(line, theta_filename, "director angle", [&](std::string_view element) {
+            double theta = parseDouble(element);
+            x_field[i].push_back(cos(theta));
+            y_field[i].push_back(sin(theta));
+        });
+    });
+}
+
+std::vector<std::vector<uint8_t>> readFileToTableInt(const std::string &filename, int threads) {
+    MappedLines lines(filename);
+    std::vector<std::vector<uint8_t>> table(lines.size());
+    parseLines(lines, threads, [&](size_t i, std::string_view line) {
+        table[i].reserve(countElements(line));
+        forEachElement(line, filename, "integer", [&](std::string_view element) {
+            table[i].push_back(parseUint8(element));
+        });
+    });
+    return table;
 }
 
 //std::vector<std::vector<bool>> readFileToTableBool(std::string &filename) {
@@ -30,16 +30,21 @@
 #include <string>
 #include "../coord.h"
 
-std::vector<std::vector<double>> readFileToTableDouble(const std::string &filename);
+/// Reads a comma-separated table from a memory-mapped file, with the threads parsing blocks of rows in parallel
+std::vector<std::vector<double>> readFileToTableDouble(const std::string &filename, int threads);
 
-std::vector<std::vector<uint8_t>> tableDoubleToInt(std::vector<std::vector<double>> &double_table);
-
-std::vector<std::vector<uint8_t>> readFileToTableInt(const std::string &filename);
+/// Reads a comma-separated table straight into uint8_t, as used for the shape
+std::vector<std::vector<uint8_t>> readFileToTableInt(const std::string &filename, int threads);
 
 std::vector<int> getTableDimensions(std::string &filename);
 
 std::vector<int> getTableDimensions(const std::vector<std::vector<uint8_t>> &table);
 
-std::vector<std::vector<coord_d>> readFileToTableDoubleVector(const std::string &filename);
+/// Reads a table of comma-separated pairs of numbers into vectors
+std::vector<std::vector<coord_d>> readFileToTableDoubleVector(const std::string &filename, int threads);
+
+/// Reads a table of director angles straight into the tables of x and y components of the director
+void readFileToDirectorTables(const std::string &theta_filename, std::vector<std::vector<double>> &x_field,
+                              std::vector<std::vector<double>> &y_field, int threads);
 
 #endif //VECTOR_SLICER_TABLE_READING_H
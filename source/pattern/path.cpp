@@ -56,6 +56,11 @@ unsigned int Path::size() const {
     return sequence_of_positions.size();
 }
 
+size_t Path::getAllocatedBytes() const {
+    return overlap.capacity() * sizeof(double) + (sequence_of_positions.capacity() + positive_path_edge.capacity() +
+                                                   negative_path_edge.capacity()) * sizeof(coord_d);
+}
+
 template<typename T>
 std::vector<T> joinVectors(std::vector<T> forward_vector, std::vector<T> backward_vector) {
     std::reverse(backward_vector.begin(), backward_vector.end());
@@ -108,6 +113,10 @@ const SeedPoint &Path::getSeedPoint() const {
     return seed_point;
 }
 
+void Path::setSeedLine(int seed_line) {
+    seed_point = SeedPoint(seed_point.getCoordinates(), seed_point.getDirector(), seed_line, seed_point.getIndex());
+}
+
 /// Returns distance between the point and the first() point.
 double Path::vectorDistance(const coord_d &point) const {
     return norm(point - first());
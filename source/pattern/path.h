@@ -65,6 +65,9 @@ public:
 
     [[nodiscard]] unsigned int size() const;
 
+    /// Memory taken by the positions, edges and overlaps of the path in bytes
+    [[nodiscard]] size_t getAllocatedBytes() const;
+
     [[nodiscard]] coord_d secondToLast() const;
 
     [[nodiscard]] coord_d second() const;
@@ -73,6 +76,9 @@ public:
 
     const SeedPoint &getSeedPoint() const;
 
+    /// Moves the seed point to another seed line, used when the paths of separately filled islands are merged
+    void setSeedLine(int seed_line);
+
     /// Vector or tensor distance
     double distance(const coord_d &point, bool is_vector_filled);
 
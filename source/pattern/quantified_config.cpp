@@ -38,6 +38,7 @@
 #include <random>
 #include <iostream>
 #include <thread>
+#include <unordered_map>
 
 QuantifiedConfig::QuantifiedConfig(const FilledPattern &pattern,
                                    const Simulation &simulation) :
@@ -53,6 +54,7 @@ QuantifiedConfig::QuantifiedConfig(const DesiredPattern &desired_pattern, const
 
 QuantifiedConfig::QuantifiedConfig(QuantifiedConfig &template_config, vectord parameters) :
         QuantifiedConfig(template_config) {
+    seed_metrics.clear();
     vecd vector_parameters(parameters.begin(), parameters.end());
     if (isCollisionRadiusOptimised()) {
         setConfigOption(TerminationRadius, std::to_string(vector_parameters.back()));
@@ -74,7 +76,12 @@ QuantifiedConfig::QuantifiedConfig(QuantifiedConfig &template_config, vectord pa
 
 QuantifiedConfig::QuantifiedConfig(QuantifiedConfig &template_config, int seed) :
         QuantifiedConfig(template_config) {
+    seed_metrics.clear();
     setSeed(seed);
+    if (is_filled) {
+        clearFill();
+        is_filled = false;
+    }
 }
 
 
@@ -88,7 +95,7 @@ double QuantifiedConfig::calculateEmptySpots() {
         for (int j = 0; j < y_size; j++) {
             if (desired_pattern.get().getShapeMatrix()[i][j] == 1) {
                 number_of_elements++;
-                if (number_of_times_filled[i][j] == 0) {
+                if (number_of_times_filled.get(i, j) == 0) {
                     number_of_empty_spots++;
                 }
             }
@@ -110,8 +117,8 @@ double QuantifiedConfig::calculateAverageOverlap() {
 
     for (int i = 0; i < x_size; i++) {
         for (int j = 0; j < y_size; j++) {
-            if (number_of_times_filled[i][j] > 0) {
-                total_overlap += number_of_times_filled[i][j] - 1;
+            if (number_of_times_filled.get(i, j) > 0) {
+                total_overlap += number_of_times_filled.get(i, j) - 1;
                 total_filled_elements++;
             }
         }
@@ -128,7 +135,7 @@ double QuantifiedConfig::localDirectorAgreement(int i, int j) {
     if (!desired_pattern.get().getShapeMatrix()[i][j]) {
         return 1;
     }
-    coord_d filled_director = normalized(coord_d{x_field_filled[i][j], y_field_filled[i][j]});
+    coord_d filled_director = normalized(coord_d{x_field_filled.get(i, j), y_field_filled.get(i, j)});
     coord_d desired_director = desired_pattern.get().getDirector(coord{i, j});
 
     double director_agreement = std::fabs(dot(filled_director, desired_director));
@@ -160,7 +167,7 @@ double QuantifiedConfig::calculateDirectorDisagreement() {
 
     for (int i = 0; i < x_size; i++) {
         for (int j = 0; j < y_size; j++) {
-            if (number_of_times_filled[i][j] > 0 && desired_pattern.get().getShapeMatrix()[i][j]) {
+            if (number_of_times_filled.get(i, j) > 0 && desired_pattern.get().getShapeMatrix()[i][j]) {
                 director_agreement += localDirectorAgreement(i, j);
                 number_of_filled_elements++;
             }
@@ -178,17 +185,32 @@ double QuantifiedConfig::calculateDirectorDisagreement() {
     }
 }
 
-void QuantifiedConfig::evaluate() {
+void QuantifiedConfig::evaluate(int threads) {
 #ifdef TIMING
     auto t1 = std::chrono::high_resolution_clock::now();
 #endif
     setup();
-    fillWithPaths(*this);
+    fillWithPaths(*this, threads);
     empty_spots = calculateEmptySpots();
     average_overlap = calculateAverageOverlap();
     average_director_disagreement = calculateDirectorDisagreement();
 
     paths_number = (double) getSequenceOfPaths().size();
+    is_filled = true;
+    calculateDisagreement();
+#ifdef TIMING
+    time_t end_time;
+    time(&end_time);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> ms = t2 - t1;
+    double ns_per_pix =
+            1000000 * ms.count() / (desired_pattern.get().getDimensions()[0] * desired_pattern.get().getDimensions()[1]);
+    std::cout << "Iteration duration: " << ms.count() << " ms (" << ns_per_pix << " ns/pix)" << std::endl;
+    throw std::runtime_error("Timing finished.");
+#endif
+}
+
+void QuantifiedConfig::calculateDisagreement() {
     path_multiplier = fmax(pow(paths_number, getPathsPower()), 1);
 
     disagreement_norm = getEmptySpotWeight() + getOverlapWeight() + getDirectorWeight();
@@ -204,16 +226,55 @@ void QuantifiedConfig::evaluate() {
     disagreement = empty_spot_disagreement + overlap_disagreement + director_disagreement;
 
     total_disagreement = disagreement * path_multiplier;
-#ifdef TIMING
-    time_t end_time;
-    time(&end_time);
-    auto t2 = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> ms = t2 - t1;
-    double ns_per_pix =
-            1000000 * ms.count() / (desired_pattern.get().getDimensions()[0] * desired_pattern.get().getDimensions()[1]);
-    std::cout << "Iteration duration: " << ms.count() << " ms (" << ns_per_pix << " ns/pix)" << std::endl;
-    throw std::runtime_error("Timing finished.");
-#endif
+}
+
+void QuantifiedConfig::evaluateWithCache(int threads) {
+    if (evaluation_cache) {
+        FillMetrics metrics;
+        if (evaluation_cache->find(*this, metrics)) {
+            setMetrics(metrics);
+            return;
+        }
+    }
+    evaluate(threads);
+    if (evaluation_cache) {
+        evaluation_cache->insert(*this, getMetrics());
+    }
+}
+
+void QuantifiedConfig::setEvaluationCache(std::shared_ptr<EvaluationCache> cache) {
+    evaluation_cache = std::move(cache);
+}
+
+const std::vector<FillMetrics> &QuantifiedConfig::getSeedMetrics() const {
+    return seed_metrics;
+}
+
+void QuantifiedConfig::setSeedMetrics(std::vector<FillMetrics> metrics) {
+    seed_metrics = std::move(metrics);
+}
+
+bool QuantifiedConfig::isFilled() const {
+    return is_filled;
+}
+
+const std::shared_ptr<EvaluationCache> &QuantifiedConfig::getEvaluationCache() const {
+    return evaluation_cache;
+}
+
+FillMetrics QuantifiedConfig::getMetrics() const {
+    return {empty_spots, average_overlap, average_director_disagreement, average_angular_director_disagreement,
+            paths_number, director_disagreement_distribution};
+}
+
+void QuantifiedConfig::setMetrics(const FillMetrics &metrics) {
+    empty_spots = metrics.empty_spots;
+    average_overlap = metrics.average_overlap;
+    average_director_disagreement = metrics.average_director_disagreement;
+    average_angular_director_disagreement = metrics.average_angular_director_disagreement;
+    paths_number = metrics.paths_number;
+    director_disagreement_distribution = metrics.director_disagreement_distribution;
+    calculateDisagreement();
 }
 
 void QuantifiedConfig::printDisagreement() const {
@@ -264,21 +325,58 @@ FilledPattern QuantifiedConfig::getFilledPattern() const {
     return *this;
 }
 
+/// Splits the threads between the patterns filled in parallel and the islands of each of them. While it exists, one
+/// level of nested parallelism is allowed if the islands get more than one thread.
+class ThreadSplit {
+    int max_active_levels = omp_get_max_active_levels();
+
+public:
+    const int pattern_threads;
+    const int island_threads;
+
+    ThreadSplit(int patterns, int threads) :
+            pattern_threads(std::max(1, std::min(patterns, threads))),
+            island_threads(std::max(1, threads / pattern_threads)) {
+        if (island_threads > 1) {
+            omp_set_max_active_levels(std::max(max_active_levels, 2));
+        }
+    }
+
+    ThreadSplit(const ThreadSplit &) = delete;
+
+    ThreadSplit &operator=(const ThreadSplit &) = delete;
+
+    ~ThreadSplit() {
+        omp_set_max_active_levels(max_active_levels);
+    }
+};
+
 double QuantifiedConfig::getDisagreement(int seeds, int threads, bool is_disagreement_details_printed,
                                          double disagreement_percentile) {
     std::vector<double> disagreements(seeds);
-    omp_set_num_threads(threads);
-#pragma omp parallel for
-    for (int i = 0; i < seeds; i++) {
-        QuantifiedConfig current_config(*this, i);
-        current_config.evaluate();
-        disagreements[i] = current_config.getDisagreement();
+    seed_metrics = std::vector<FillMetrics>(seeds);
+    {
+        ThreadSplit split(seeds, threads);
+#pragma omp parallel for num_threads(split.pattern_threads)
+        for (int i = 0; i < seeds; i++) {
+            QuantifiedConfig current_config(*this, i);
+            current_config.evaluateWithCache(split.island_threads);
+            disagreements[i] = current_config.getDisagreement();
+            seed_metrics[i] = current_config.getMetrics();
+        }
+    }
+    if (evaluation_cache) {
+        evaluation_cache->save();
     }
 
     if (is_disagreement_details_printed) {
         std::cout << "Mean " << mean(disagreements) << ", standard deviation " << standardDeviation(disagreements)
                   << ", noise " << standardDeviation(disagreements) / mean(disagreements) << std::endl;
     }
+    return percentileDisagreement(disagreements, disagreement_percentile);
+}
+
+double percentileDisagreement(std::vector<double> disagreements, double disagreement_percentile) {
     std::sort(disagreements.begin(), disagreements.end());
     int return_index = disagreements.size() * (1 - disagreement_percentile);
     return disagreements[return_index];
@@ -300,7 +398,7 @@ double QuantifiedConfig::averagedFillDensity(const veci &position, int averaging
                 continue;
             }
             target_count += desired_pattern.get().getShapeMatrix()[x][y];
-            filling_count += number_of_times_filled[x][y];
+            filling_count += number_of_times_filled.get(x, y);
             tracked_pixels++;
         }
     }
@@ -330,33 +428,68 @@ std::vector<double> QuantifiedConfig::sampleFillDensities(uint16_t sample_count,
 }
 
 
-std::vector<QuantifiedConfig> QuantifiedConfig::findBestSeeds(int seeds, int threads) {
-    std::vector<QuantifiedConfig> configs_with_various_seeds;
-    std::vector<std::pair<double, unsigned int>> disagreements(seeds);
+bool isBetterFill(const QuantifiedConfig &left, const QuantifiedConfig &right) {
+    if (left.getDisagreement() == right.getDisagreement()) {
+        return left.getConfig().getSeed() < right.getConfig().getSeed();
+    }
+    return left.getDisagreement() < right.getDisagreement();
+}
 
-    omp_set_num_threads(threads);
-#pragma omp parallel for
-    for (int i = 0; i < seeds; i++) {
-        QuantifiedConfig current_config(*this, i);
-        current_config.evaluate();
-        disagreements[i] = {current_config.getDisagreement(), i};
+/// Inserts the config into the sorted list of best configs, keeping at most number_of_configs of them.
+void insertIntoBestConfigs(std::vector<QuantifiedConfig> &best_configs, QuantifiedConfig &config,
+                           size_t number_of_configs) {
+    if (best_configs.size() >= number_of_configs && !isBetterFill(config, best_configs.back())) {
+        return;
+    }
+    auto position = std::upper_bound(best_configs.begin(), best_configs.end(), config, isBetterFill);
+    best_configs.insert(position, std::move(config));
+    if (best_configs.size() > number_of_configs) {
+        best_configs.pop_back();
     }
+}
 
-    std::sort(disagreements.begin(), disagreements.end(), [](auto &left, auto &right) {
-        return (left.first < right.first);
-    });
+std::vector<QuantifiedConfig>
+QuantifiedConfig::findBestSeeds(int seeds, int threads, std::chrono::steady_clock::time_point deadline) {
     int number_of_layers = getNumberOfLayers();
-
-    std::vector<QuantifiedConfig> configs_to_export;
-    configs_to_export.reserve(number_of_layers);
-    for (int i = 0; i < number_of_layers; i++) {
-        configs_to_export.emplace_back(*this, disagreements[i].second);
+    // Filled patterns of the best seeds are kept during the scan, so that they do not have to be filled again.
+    std::vector<QuantifiedConfig> best_configs;
+    best_configs.reserve(number_of_layers + 1);
+    int skipped_seeds = 0;
+
+    {
+        ThreadSplit split(seeds, threads);
+#pragma omp parallel for num_threads(split.pattern_threads) reduction(+:skipped_seeds)
+        for (int i = 0; i < seeds; i++) {
+            QuantifiedConfig current_config(*this, i);
+            if (i < seed_metrics.size()) {
+                current_config.setMetrics(seed_metrics[i]);
+            } else if (i >= number_of_layers && std::chrono::steady_clock::now() > deadline) {
+                skipped_seeds++;
+                continue;
+            } else {
+                current_config.evaluateWithCache(split.island_threads);
+            }
+#pragma omp critical
+            insertIntoBestConfigs(best_configs, current_config, number_of_layers);
+        }
+    }
+    if (evaluation_cache) {
+        evaluation_cache->save();
+    }
+    if (skipped_seeds > 0) {
+        std::cout << "Time limit reached. " << seeds - skipped_seeds << " out of " << seeds << " seeds were scanned."
+                  << std::endl;
     }
-#pragma omp parallel for
-    for (int i = 0; i < number_of_layers; i++) {
-        configs_to_export[i].evaluate();
+
+    // Only the seeds whose metrics were known or retrieved from the evaluation cache need to be filled.
+    ThreadSplit split((int) best_configs.size(), threads);
+#pragma omp parallel for num_threads(split.pattern_threads)
+    for (int i = 0; i < best_configs.size(); i++) {
+        if (!best_configs[i].isFilled()) {
+            best_configs[i].evaluate(split.island_threads);
+        }
     }
-    return configs_to_export;
+    return best_configs;
 }
 
 std::vector<std::vector<double>> QuantifiedConfig::localDisagreementGrid() {
@@ -368,17 +501,17 @@ std::vector<std::vector<double>> QuantifiedConfig::localDisagreementGrid() {
         std::vector<double> disagreement_row;
         for (int j = 0; j < y_size; j++) {
             double local_disagreement = 0;
-            if (desired_pattern.get().getShapeMatrix()[i][j] == 1 && number_of_times_filled[i][j] == 0) {
+            if (desired_pattern.get().getShapeMatrix()[i][j] == 1 && number_of_times_filled.get(i, j) == 0) {
                 local_disagreement +=
                         getEmptySpotWeight() * getEmptySpotPower() * pow(empty_spots, getEmptySpotPower() - 1);
             }
-            if (number_of_times_filled[i][j] > 1) {
-                int local_overlap = number_of_times_filled[i][j] - 1;
+            if (number_of_times_filled.get(i, j) > 1) {
+                int local_overlap = number_of_times_filled.get(i, j) - 1;
                 local_disagreement +=
                         getOverlapWeight() * getOverlapPower() * pow(average_overlap, getOverlapPower() - 1) *
                         local_overlap;
             }
-            if (number_of_times_filled[i][j] > 0) {
+            if (number_of_times_filled.get(i, j) > 0) {
                 double local_director_disagreement = 1 - localDirectorAgreement(i, j);
                 local_disagreement +=
                         getDirectorWeight() * getDirectorPower() *
@@ -398,4 +531,55 @@ const std::vector<unsigned int> &QuantifiedConfig::getDirectorDisagreementDistri
     return director_disagreement_distribution;
 }
 
+double disagreementFromMetrics(const FillMetrics &metrics, const DisagreementFunctionConfig &disagreement_function) {
+    double path_multiplier = fmax(pow(metrics.paths_number, disagreement_function.getPathsPower()), 1);
+    double disagreement_norm = disagreement_function.getEmptySpotWeight() + disagreement_function.getOverlapWeight() +
+                               disagreement_function.getDirectorWeight();
+    if (disagreement_norm <= 0) {
+        throw std::runtime_error("Sum of disagreement weights must be positive.");
+    }
+
+    double disagreement =
+            disagreement_function.getEmptySpotWeight() *
+            pow(metrics.empty_spots, disagreement_function.getEmptySpotPower()) / disagreement_norm +
+            disagreement_function.getOverlapWeight() *
+            pow(metrics.average_overlap, disagreement_function.getOverlapPower()) / disagreement_norm +
+            disagreement_function.getDirectorWeight() *
+            pow(metrics.average_director_disagreement, disagreement_function.getDirectorPower()) / disagreement_norm;
+    return disagreement * path_multiplier;
+}
+
+std::vector<RescoredParameters>
+rescoreEvaluations(const std::vector<CachedEvaluation> &evaluations, const Simulation &simulation, int seeds) {
+    std::unordered_map<uint64_t, RescoredParameters> parameters_map;
+    for (const CachedEvaluation &evaluation: evaluations) {
+        if (evaluation.seed >= (unsigned int) seeds) {
+            continue;
+        }
+        RescoredParameters &rescored = parameters_map[evaluation.getParametersKey()];
+        if (rescored.seed_disagreements.empty()) {
+            rescored.parameters = evaluation;
+            rescored.seed_disagreements = std::vector<double>(seeds, DBL_MAX);
+        }
+        rescored.seed_disagreements[evaluation.seed] = disagreementFromMetrics(evaluation.metrics, simulation);
+    }
 
+    std::vector<RescoredParameters> rescored_parameters;
+    rescored_parameters.reserve(parameters_map.size());
+    for (auto &element: parameters_map) {
+        RescoredParameters &rescored = element.second;
+        std::vector<double> sorted_disagreements = rescored.seed_disagreements;
+        std::sort(sorted_disagreements.begin(), sorted_disagreements.end());
+        if (sorted_disagreements.back() == DBL_MAX) {
+            continue;
+        }
+        int percentile_index = sorted_disagreements.size() * (1 - simulation.getAgreementPercentile());
+        percentile_index = std::min(percentile_index, (int) sorted_disagreements.size() - 1);
+        rescored.disagreement = sorted_disagreements[percentile_index];
+        rescored_parameters.emplace_back(rescored);
+    }
+    std::sort(rescored_parameters.begin(), rescored_parameters.end(), [](auto &left, auto &right) {
+        return (left.disagreement < right.disagreement);
+    });
+    return rescored_parameters;
+}
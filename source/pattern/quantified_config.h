@@ -28,9 +28,12 @@
 #include "filled_pattern.h"
 #include "simulation/simulation.h"
 #include "coord.h"
+#include "evaluation_cache.h"
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <cfloat>
+#include <chrono>
+#include <memory>
 
 #define DISAGREEMENT_BUCKET_COUNT 90
 
@@ -54,6 +57,10 @@ class QuantifiedConfig : FilledPattern, public Simulation {
     double bucket_size = M_PI_2 / (DISAGREEMENT_BUCKET_COUNT - 1);
     double total_angular_director_disagreement = 0;
     double average_angular_director_disagreement = DBL_MAX;
+    std::shared_ptr<EvaluationCache> evaluation_cache;
+    bool is_filled = false;
+    /// Metrics of consecutive seeds of the generating parameters, which are already known
+    std::vector<FillMetrics> seed_metrics;
 
     double calculateEmptySpots();
 
@@ -67,6 +74,9 @@ class QuantifiedConfig : FilledPattern, public Simulation {
 
     double averagedFillDensity(const veci &position, int averaging_radius) const;
 
+    /// Calculates the disagreement from the metrics of the filled pattern
+    void calculateDisagreement();
+
 public:
 
     QuantifiedConfig(const FilledPattern &pattern, const Simulation &simulation);
@@ -82,6 +92,9 @@ public:
 
     [[nodiscard]] FilledPattern getFilledPattern() const;
 
+    /// Memory taken by the filled fields and the paths in bytes
+    using FilledPattern::getAllocatedBytes;
+
     DesiredPattern getDesiredPattern() const;
 
     [[nodiscard]] FillingConfig getConfig() const;
@@ -90,15 +103,39 @@ public:
 
     const std::vector<unsigned int> &getDirectorDisagreementDistribution() const;
 
-    /// Fills the pattern
-    void evaluate();
+    /// Fills the pattern, with the threads filling its islands in parallel
+    void evaluate(int threads = 1);
+
+    /// Retrieves the metrics from the evaluation cache if they are present, otherwise fills the pattern and stores them
+    void evaluateWithCache(int threads = 1);
+
+    void setEvaluationCache(std::shared_ptr<EvaluationCache> cache);
+
+    /// Whether the paths of the pattern were generated, as opposed to its metrics being retrieved from the cache
+    [[nodiscard]] bool isFilled() const;
+
+    [[nodiscard]] FillMetrics getMetrics() const;
+
+    [[nodiscard]] const std::shared_ptr<EvaluationCache> &getEvaluationCache() const;
+
+    /// Sets the metrics of the pattern without filling it and recalculates the disagreement
+    void setMetrics(const FillMetrics &metrics);
 
-    /// Returns percentile based disagreement for a number of seeds
+    [[nodiscard]] const std::vector<FillMetrics> &getSeedMetrics() const;
+
+    /// Sets the metrics of seeds starting from 0, which will not be filled again when scanning seeds
+    void setSeedMetrics(std::vector<FillMetrics> metrics);
+
+    /// Returns percentile based disagreement for a number of seeds. Metrics of each seed are stored as seed metrics.
+    /// Threads left over when there are fewer seeds than threads fill the islands of each seed.
     double getDisagreement(int seeds, int threads, bool is_disagreement_details_printed,
                            double disagreement_percentile);
 
-    /// Evaluates number of seeds and sorts them according to their disagreement
-    std::vector<QuantifiedConfig> findBestSeeds(int seeds, int threads);
+    /// Evaluates number of seeds and sorts them according to their disagreement. Seeds with known metrics are not
+    /// filled unless they are among the best ones. Seeds beyond the number of layers are not evaluated after the
+    /// deadline. Threads left over when there are fewer seeds than threads fill the islands of each seed.
+    std::vector<QuantifiedConfig> findBestSeeds(int seeds, int threads, std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::time_point::max());
 
     void printDisagreement() const;
 
@@ -107,5 +144,23 @@ public:
     std::vector<double> sampleFillDensities(uint16_t sample_count, int averaging_radius) const;
 };
 
+/// Disagreement of a set of generating parameters recalculated from the cached evaluations of its seeds
+struct RescoredParameters {
+    CachedEvaluation parameters;
+    std::vector<double> seed_disagreements;
+    double disagreement = DBL_MAX;
+};
+
+/// Disagreement of a set of generating parameters from the disagreements of its seeds at the given percentile
+double percentileDisagreement(std::vector<double> disagreements, double disagreement_percentile);
+
+/// Calculates the disagreement of a filled pattern from its metrics using the current disagreement function
+double disagreementFromMetrics(const FillMetrics &metrics, const DisagreementFunctionConfig &disagreement_function);
+
+/// Recalculates the disagreement of cached evaluations with the current disagreement function and sorts the generating
+/// parameters by it. Only the parameters whose first number of seeds were all evaluated are returned.
+std::vector<RescoredParameters>
+rescoreEvaluations(const std::vector<CachedEvaluation> &evaluations, const Simulation &simulation, int seeds);
+
 
 #endif //VECTOR_SLICER_QUANTIFIED_CONFIG_H
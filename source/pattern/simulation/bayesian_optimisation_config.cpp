@@ -33,14 +33,24 @@
 BayesianOptimisationConfig::BayesianOptimisationConfig(const fs::path &config_path) {
     total_iterations = readKeyInt(config_path, "number_of_iterations");
     improvement_iterations = readKeyInt(config_path, "number_of_improvement_iterations");
+    expected_improvement_fraction = readKeyOr(config_path, "expected_improvement_fraction", 0.0);
+    low_expected_improvement_iterations = readKeyOr(config_path, "low_expected_improvement_iterations", 10);
     relearning_iterations = readKeyInt(config_path, "iterations_between_relearning");
     noise = readKeyDouble(config_path, "noise");
+    acquisition_starts = readKeyOr(config_path, "acquisition_starts", 0);
+    surrogate_window = readKeyOr(config_path, "surrogate_window", 0);
+    refinement_step = readKeyOr(config_path, "refinement_step", 0.0);
+    reference_patterns = readKeyOr(config_path, "reference_patterns", std::vector<std::string>());
+    reference_samples = readKeyOr(config_path, "reference_samples", 10);
+    time_limit = readKeyOr(config_path, "time_limit", 0.0);
     print_verbose = readKeyInt(config_path, "print_verbose");
 
     is_collision_radius_optimised = readKeyBool(config_path, "is_collision_radius_optimised");
     is_starting_point_separation_optimised = readKeyBool(config_path, "is_starting_point_separation_optimised");
     is_repulsion_magnitude_optimised = readKeyBool(config_path, "is_repulsion_magnitude_optimised");
     is_repulsion_angle_optimised = readKeyBool(config_path, "is_repulsion_angle_optimised");
+
+    is_optimisation_resumed = readKeyOr(config_path, "is_optimisation_resumed", false);
 }
 
 
@@ -54,23 +64,57 @@ BayesianOptimisationConfig::BayesianOptimisationConfig(const fs::path &local_pat
 }
 
 
+std::string BayesianOptimisationConfig::joinedReferencePatterns() const {
+    std::string joined;
+    for (const std::string &pattern_name: reference_patterns) {
+        if (!joined.empty()) {
+            joined += ", ";
+        }
+        joined += pattern_name;
+    }
+    return joined;
+}
+
 std::string BayesianOptimisationConfig::textBayesianOptimisationConfig() const {
     std::ostringstream textForm;
     textForm << "# Number of sets of generating parameters to iterate over in Bayesian optimisation."
              << "\nnumber_of_iterations = " << total_iterations
              << "\n\n# If the disagreement does not improve in this many iterations, then the algorithm finishes. Set to 0 to disable it."
              << "\nnumber_of_improvement_iterations = " << improvement_iterations
+             << "\n\n# If the expected improvement of the next set of generating parameters stays below this fraction of the minimal"
+             << "\n# disagreement for low_expected_improvement_iterations iterations, then the algorithm finishes. Set to 0 to disable it."
+             << "\nexpected_improvement_fraction = " << expected_improvement_fraction
+             << "\nlow_expected_improvement_iterations = " << low_expected_improvement_iterations
              << "\n\n# Number of iterations after which the model relearns based on all previous data points."
              << "\niterations_between_relearning = " << relearning_iterations
              << "\n\n# Assumed data noise. Larger values looks for new global minima while lower values probes the local minimum more precisely."
              << "\nnoise = " << noise
+             << "\n\n# Number of local searches of the acquisition function that are run in parallel to choose the next set of"
+             << "\n# generating parameters. Set to 0 to use a single global search."
+             << "\nacquisition_starts = " << acquisition_starts
+             << "\n\n# Number of samples the model is conditioned on, made of the best and the most recent ones, which keeps the"
+             << "\n# time of each iteration bounded in long optimisations. Set to 0 to condition the model on all samples."
+             << "\nsurrogate_window = " << surrogate_window
+             << "\n\n# After the optimisation, neighbours of the best set of generating parameters, displaced by this fraction of the"
+             << "\n# range of each parameter, are evaluated in parallel and the best of them is used. Set to 0 to disable it."
+             << "\nrefinement_step = " << refinement_step
+             << "\n\n# Comma separated names of related patterns, whose best evaluated sets of generating parameters are evaluated first"
+             << "\n# and replace the initial samples of the optimisation, up to reference_samples of them. Leave empty to disable it."
+             << "\nreference_patterns = " << joinedReferencePatterns()
+             << "\nreference_samples = " << reference_samples
+             << "\n\n# Time in seconds after which optimising a pattern finishes, including the final seed scan. The optimisation"
+             << "\n# finishes early to leave time for the scan, which stops at the limit. Set to 0 to disable it."
+             << "\ntime_limit = " << time_limit
              << "\n\n# How to print logs. - (0 - error, 1 - info, 2 - debug) to std::cout, (3, 4, 5) same but to log.txt"
              << "\nprint_verbose = " << print_verbose
              << "\n\n# Settings to choose which parameters are optimised"
              << "\nis_collision_radius_optimised = " << is_collision_radius_optimised
              << "\nis_starting_point_separation_optimised = " << is_starting_point_separation_optimised
              << "\nis_repulsion_magnitude_optimised = " << is_repulsion_magnitude_optimised
-             << "\nis_repulsion_angle_optimised = " << is_repulsion_angle_optimised;
+             << "\nis_repulsion_angle_optimised = " << is_repulsion_angle_optimised
+             << "\n\n# Switch to resume the optimisation from the journal of the previous run of the same pattern, also warm-starting it"
+             << "\n# from the evaluation cache if it is used. Otherwise the journal is started anew."
+             << "\nis_optimisation_resumed = " << is_optimisation_resumed;
     return textForm.str();
 }
 
@@ -120,13 +164,21 @@ void BayesianOptimisationConfig::editBayesianOptimisationConfig() {
         std::cout << "Editing Bayesian optimisation config." << std::endl;
         editInt(total_iterations, "total_iterations");
         editInt(improvement_iterations, "improvement_iterations");
+        editDouble(expected_improvement_fraction, "expected_improvement_fraction");
+        editInt(low_expected_improvement_iterations, "low_expected_improvement_iterations");
         editInt(relearning_iterations, "relearning_iterations");
         editDouble(noise, "noise");
+        editInt(acquisition_starts, "acquisition_starts");
+        editInt(surrogate_window, "surrogate_window");
+        editDouble(refinement_step, "refinement_step");
+        editInt(reference_samples, "reference_samples");
+        editDouble(time_limit, "time_limit");
         editInt(print_verbose, "print_verbose");
         editBool(is_collision_radius_optimised, "is_collision_radius_optimised");
         editBool(is_starting_point_separation_optimised, "is_starting_point_separation_optimised");
         editBool(is_repulsion_magnitude_optimised, "is_repulsion_magnitude_optimised");
         editBool(is_repulsion_angle_optimised, "is_repulsion_angle_optimised");
+        editBool(is_optimisation_resumed, "is_optimisation_resumed");
 
         std::cout << std::endl << "Current configuration:" << std::endl;
         printBayesianOptimisationConfig();
@@ -144,6 +196,14 @@ int BayesianOptimisationConfig::getImprovementIterations() const {
     return improvement_iterations;
 }
 
+double BayesianOptimisationConfig::getExpectedImprovementFraction() const {
+    return expected_improvement_fraction;
+}
+
+int BayesianOptimisationConfig::getLowExpectedImprovementIterations() const {
+    return low_expected_improvement_iterations;
+}
+
 int BayesianOptimisationConfig::getRelearningIterations() const {
     return relearning_iterations;
 }
@@ -152,6 +212,30 @@ double BayesianOptimisationConfig::getNoise() const {
     return noise;
 }
 
+int BayesianOptimisationConfig::getAcquisitionStarts() const {
+    return acquisition_starts;
+}
+
+int BayesianOptimisationConfig::getSurrogateWindow() const {
+    return surrogate_window;
+}
+
+double BayesianOptimisationConfig::getRefinementStep() const {
+    return refinement_step;
+}
+
+const std::vector<std::string> &BayesianOptimisationConfig::getReferencePatterns() const {
+    return reference_patterns;
+}
+
+int BayesianOptimisationConfig::getReferenceSamples() const {
+    return reference_samples;
+}
+
+double BayesianOptimisationConfig::getTimeLimit() const {
+    return time_limit;
+}
+
 int BayesianOptimisationConfig::getPrintVerbose() const {
     return print_verbose;
 }
@@ -171,3 +255,7 @@ bool BayesianOptimisationConfig::isRepulsionMagnitudeOptimised() const {
 bool BayesianOptimisationConfig::isRepulsionAngleOptimised() const {
     return is_repulsion_angle_optimised;
 }
+
+bool BayesianOptimisationConfig::isOptimisationResumed() const {
+    return is_optimisation_resumed;
+}
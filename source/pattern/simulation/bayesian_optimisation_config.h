@@ -26,14 +26,24 @@
 #define VECTOR_SLICER_BAYESIAN_OPTIMISATION_CONFIG_H
 
 #include <boost/filesystem.hpp>
+#include <string>
+#include <vector>
 
 namespace fs = boost::filesystem;
 
 class BayesianOptimisationConfig {
     int total_iterations{};
     int improvement_iterations{};
+    double expected_improvement_fraction{};
+    int low_expected_improvement_iterations{};
     int relearning_iterations{};
     double noise{};
+    int acquisition_starts{};
+    int surrogate_window{};
+    double refinement_step{};
+    std::vector<std::string> reference_patterns;
+    int reference_samples{};
+    double time_limit{};
     int print_verbose{};
 
     bool is_collision_radius_optimised{};
@@ -41,7 +51,11 @@ class BayesianOptimisationConfig {
     bool is_repulsion_magnitude_optimised{};
     bool is_repulsion_angle_optimised{};
 
+    bool is_optimisation_resumed{};
+
     std::string textBayesianOptimisationConfig() const;
+
+    std::string joinedReferencePatterns() const;
 public:
 
     explicit BayesianOptimisationConfig(const fs::path &config_path);
@@ -60,10 +74,26 @@ public:
 
     int getImprovementIterations() const;
 
+    double getExpectedImprovementFraction() const;
+
+    int getLowExpectedImprovementIterations() const;
+
     int getRelearningIterations() const;
 
     double getNoise() const;
 
+    int getAcquisitionStarts() const;
+
+    int getSurrogateWindow() const;
+
+    double getRefinementStep() const;
+
+    const std::vector<std::string> &getReferencePatterns() const;
+
+    int getReferenceSamples() const;
+
+    double getTimeLimit() const;
+
     int getPrintVerbose() const;
 
     bool isCollisionRadiusOptimised() const;
@@ -73,6 +103,8 @@ public:
     bool isRepulsionMagnitudeOptimised() const;
 
     bool isRepulsionAngleOptimised() const;
+
+    bool isOptimisationResumed() const;
 };
 
 
@@ -38,16 +38,31 @@ std::string findSuffix(const std::string &str, char suffix) {
 }
 
 
-std::string readKey(const fs::path &file_path, const std::string &key) {
+/// Finds the value of the key. Returns false if the config file does not contain the key.
+bool findKey(const fs::path &file_path, const std::string &key, std::string &value) {
     std::string line;
     std::ifstream file(file_path.string());
     while (std::getline(file, line)) {
         std::string clean_line = cleanString(line);
         if (clean_line.find(key) != std::string::npos) {
-            return findSuffix(clean_line, '=');
+            value = findSuffix(clean_line, '=');
+            return true;
         }
     }
-    throw std::runtime_error("Key \"" + key + "\" was not found in the config file " + file_path.string());
+    return false;
+}
+
+std::string readKey(const fs::path &file_path, const std::string &key) {
+    std::string value;
+    if (!findKey(file_path, key, value)) {
+        throw std::runtime_error("Key \"" + key + "\" was not found in the config file " + file_path.string());
+    }
+    return value;
+}
+
+bool isKeyPresent(const fs::path &file_path, const std::string &key) {
+    std::string value;
+    return findKey(file_path, key, value);
 }
 
 
@@ -92,4 +107,33 @@ bool readKeyBool(const fs::path &local_file_path, const fs::path &default_file_p
     } else {
         return readKeyBool(default_file_path, key);
     }
-}
\ No newline at end of file
+}
+
+std::vector<std::string> readKeyList(const fs::path &file_path, const std::string &key) {
+    std::stringstream value_stream(readKey(file_path, key));
+    std::vector<std::string> list;
+    std::string element;
+    while (std::getline(value_stream, element, ',')) {
+        if (!element.empty()) {
+            list.emplace_back(element);
+        }
+    }
+    return list;
+}
+
+int readKeyOr(const fs::path &file_path, const std::string &key, int default_value) {
+    return isKeyPresent(file_path, key) ? readKeyInt(file_path, key) : default_value;
+}
+
+double readKeyOr(const fs::path &file_path, const std::string &key, double default_value) {
+    return isKeyPresent(file_path, key) ? readKeyDouble(file_path, key) : default_value;
+}
+
+bool readKeyOr(const fs::path &file_path, const std::string &key, bool default_value) {
+    return isKeyPresent(file_path, key) ? readKeyBool(file_path, key) : default_value;
+}
+
+std::vector<std::string> readKeyOr(const fs::path &file_path, const std::string &key,
+                                   const std::vector<std::string> &default_value) {
+    return isKeyPresent(file_path, key) ? readKeyList(file_path, key) : default_value;
+}
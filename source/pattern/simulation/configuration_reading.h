@@ -26,6 +26,7 @@
 #define VECTOR_SLICER_CONFIGURATION_READING_H
 
 #include <string>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/dll.hpp>
 
@@ -33,6 +34,8 @@ namespace fs = boost::filesystem;
 
 std::string readKey(const fs::path &file_path, const std::string &key);
 
+bool isKeyPresent(const fs::path &file_path, const std::string &key);
+
 int readKeyInt(const fs::path &file_path, const std::string &key);
 
 int readKeyInt(const fs::path &local_file_path, const fs::path &default_file_path, const std::string &key);
@@ -45,5 +48,19 @@ bool readKeyBool(const fs::path &file_path, const std::string &key);
 
 bool readKeyBool(const fs::path &local_file_path, const fs::path &default_file_path, const std::string &key);
 
+/// Reads a comma separated list. Empty value results in an empty list.
+std::vector<std::string> readKeyList(const fs::path &file_path, const std::string &key);
+
+/// Reads the key, or returns the default value if the config file does not contain it, so that config files saved
+/// before the key was introduced can still be read.
+int readKeyOr(const fs::path &file_path, const std::string &key, int default_value);
+
+double readKeyOr(const fs::path &file_path, const std::string &key, double default_value);
+
+bool readKeyOr(const fs::path &file_path, const std::string &key, bool default_value);
+
+std::vector<std::string> readKeyOr(const fs::path &file_path, const std::string &key,
+                                   const std::vector<std::string> &default_value);
+
 
 #endif //VECTOR_SLICER_CONFIGURATION_READING_H
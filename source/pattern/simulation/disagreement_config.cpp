@@ -29,6 +29,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <omp.h>
 
 
 DisagreementConfig::DisagreementConfig(const fs::path &config_path) :
@@ -37,7 +38,9 @@ DisagreementConfig::DisagreementConfig(const fs::path &config_path) :
         final_seeds(readKeyInt(config_path, "final_seeds")),
         agreement_percentile(readKeyDouble(config_path, "agreement_percentile")),
         number_of_layers(readKeyInt(config_path, "number_of_layers")),
-        is_disagreement_details_printed(readKeyBool(config_path, "is_disagreement_details_printed")) {
+        is_disagreement_details_printed(readKeyBool(config_path, "is_disagreement_details_printed")),
+        is_evaluation_cache_used(readKeyOr(config_path, "is_evaluation_cache_used", false)),
+        is_pattern_cache_used(readKeyOr(config_path, "is_pattern_cache_used", true)) {
 
 }
 
@@ -106,7 +109,13 @@ std::string DisagreementConfig::textDisagreementConfig() const {
             << "\nnumber_of_layers = " << number_of_layers
             << "\n\n# Switch to print mean disagreement, standard deviation and noise for generating parameters. Used to identify whether"
             << "\n# the noise parameter in Bayesian optimisation is correct, mostly for debugging."
-            << "\nis_disagreement_details_printed = " << is_disagreement_details_printed;
+            << "\nis_disagreement_details_printed = " << is_disagreement_details_printed
+            << "\n\n# Switch to store the metrics of every evaluated fill in output/evaluation_cache, so that repeated optimisations"
+            << "\n# of an unchanged pattern reuse them instead of filling the pattern again."
+            << "\nis_evaluation_cache_used = " << is_evaluation_cache_used
+            << "\n\n# Switch to store the prepared pattern (margins, splay, splay lines and perimeters) in output/pattern_cache, so"
+            << "\n# that re-slicing a pattern with unchanged inputs and filling.cfg does not need to prepare it again."
+            << "\nis_pattern_cache_used = " << is_pattern_cache_used;
     return textForm.str();
 }
 
@@ -124,6 +133,8 @@ void DisagreementConfig::editDisagreementConfig() {
         editDouble(agreement_percentile, "agreement_percentile");
         editInt(number_of_layers, "number_of_layers");
         editBool(is_disagreement_details_printed, "is_disagreement_details_printed");
+        editBool(is_evaluation_cache_used, "is_evaluation_cache_used");
+        editBool(is_pattern_cache_used, "is_pattern_cache_used");
 
         std::cout << std::endl << "Current configuration:" << std::endl;
         printDisagreementConfig();
@@ -134,7 +145,24 @@ void DisagreementConfig::editDisagreementConfig() {
 }
 
 int DisagreementConfig::getThreads() const {
-    return threads;
+    if (threads > 0) {
+        return threads;
+    } else if (tuned_threads > 0) {
+        return tuned_threads;
+    }
+    return omp_get_num_procs();
+}
+
+bool DisagreementConfig::isThreadsTuned() const {
+    return threads <= 0;
+}
+
+void DisagreementConfig::setTunedThreads(int threads) {
+    tuned_threads = threads;
+}
+
+int DisagreementConfig::getTunedThreads() const {
+    return tuned_threads;
 }
 
 int DisagreementConfig::getOptimisationSeeds() const {
@@ -157,3 +185,10 @@ bool DisagreementConfig::isDisagreementDetailsPrinted() const {
     return is_disagreement_details_printed;
 }
 
+bool DisagreementConfig::isEvaluationCacheUsed() const {
+    return is_evaluation_cache_used;
+}
+
+bool DisagreementConfig::isPatternCacheUsed() const {
+    return is_pattern_cache_used;
+}
@@ -31,11 +31,15 @@ namespace fs = boost::filesystem;
 
 class DisagreementConfig {
     int threads;
+    /// Number of threads chosen by calibration, used when the number of threads is not configured
+    int tuned_threads = 0;
     int optimisation_seeds;
     int final_seeds;
     double agreement_percentile;
     int number_of_layers;
     bool is_disagreement_details_printed;
+    bool is_evaluation_cache_used;
+    bool is_pattern_cache_used;
 
     std::string textDisagreementConfig() const;
 public:
@@ -51,8 +55,17 @@ public:
 
     void editDisagreementConfig();
 
+    /// Configured number of threads, otherwise the tuned one, otherwise the number of processors
     int getThreads() const;
 
+    /// Whether the number of threads is to be chosen by calibrating on the pattern
+    bool isThreadsTuned() const;
+
+    void setTunedThreads(int threads);
+
+    /// Number of threads chosen by calibrating on the pattern, or 0 if it was not calibrated
+    int getTunedThreads() const;
+
     int getOptimisationSeeds() const;
 
     int getFinalSeeds() const;
@@ -62,6 +75,10 @@ public:
     int getNumberOfLayers() const;
 
     bool isDisagreementDetailsPrinted() const;
+
+    bool isEvaluationCacheUsed() const;
+
+    bool isPatternCacheUsed() const;
 };
 
 
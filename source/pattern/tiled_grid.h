@@ -0,0 +1,261 @@
+// Copyright (c) 2026, Michał Zmyślony, mlz22@cam.ac.uk.
+//
+// Please cite following publication if you use any part of this code in work you publish or distribute:
+// [1] Michał Zmyślony M., Klaudia Dradrach, John S. Biggins,
+//    Slicing vector fields into tool paths for additive manufacturing of nematic elastomers,
+//    Additive Manufacturing, Volume 97, 2025, 104604, ISSN 2214-8604, https://doi.org/10.1016/j.addma.2024.104604.
+//
+// This file is part of Vector Slicer.
+//
+// Vector Slicer is free software: you can redistribute it and/or modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any
+// later version.
+//
+// Vector Slicer is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with Vector Slicer.
+// If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by Michał Zmyślony on 19/10/2026.
+//
+
+#ifndef VECTOR_SLICER_TILED_GRID_H
+#define VECTOR_SLICER_TILED_GRID_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "coord.h"
+
+/// \brief Two-dimensional grid stored in square tiles, which are allocated on their first write. Tiles that were never
+/// written share a single tile of default values, so the areas of the grid that are never reached do not take up memory,
+/// and reading does not need to check whether a tile is allocated. A grid can also cover only a window of a larger
+/// one, starting at its origin, and reads as default values outside of the window.
+///
+/// Grids whose tiles would all be populated are stored densely in row-major order instead, which saves the lookup of
+/// the tile on every access.
+template<typename T>
+class TiledGrid {
+    static constexpr int TILE_BITS = 5;
+    static constexpr int TILE_SIZE = 1 << TILE_BITS;
+    static constexpr int TILE_MASK = TILE_SIZE - 1;
+    static constexpr size_t TILE_AREA = TILE_SIZE * TILE_SIZE;
+
+    /// Tile of default values shared by all grids of the type. It is never written to.
+    static T *defaultTile() {
+        static std::vector<T> default_tile(TILE_AREA, T());
+        return default_tile.data();
+    }
+
+    T *default_tile = defaultTile();
+    coord origin = {0, 0};
+    int rows = 0;
+    int columns = 0;
+    int tile_columns = 0;
+    /// Elements of each tile in row-major order, with the tiles in row-major order. Points either to the owned tile or
+    /// to the default tile.
+    std::vector<T *> tiles;
+    std::vector<std::unique_ptr<T[]>> owned_tiles;
+    /// Elements of a dense grid in row-major order, which is used instead of the tiles when it is not empty
+    std::vector<T> dense_elements;
+
+    /// Index of the tile containing the position relative to the origin
+    [[nodiscard]] size_t tileIndex(int x, int y) const {
+        return (size_t) (x >> TILE_BITS) * tile_columns + (y >> TILE_BITS);
+    }
+
+    T *allocateTile(size_t tile_index) {
+        if (tiles[tile_index] == default_tile) {
+            owned_tiles[tile_index].reset(new T[TILE_AREA]());
+            tiles[tile_index] = owned_tiles[tile_index].get();
+        }
+        return tiles[tile_index];
+    }
+
+    [[nodiscard]] static size_t elementIndex(int x, int y) {
+        return ((size_t) (x & TILE_MASK) << TILE_BITS) | (size_t) (y & TILE_MASK);
+    }
+
+    [[nodiscard]] size_t denseIndex(int x, int y) const {
+        return (size_t) x * columns + y;
+    }
+
+public:
+    TiledGrid() = default;
+
+    TiledGrid(int rows, int columns, const coord &origin = {0, 0}, bool is_dense = false) :
+            origin(origin),
+            rows(rows),
+            columns(columns),
+            tile_columns((columns + TILE_MASK) >> TILE_BITS) {
+        if (is_dense) {
+            dense_elements.assign((size_t) rows * columns, T());
+            return;
+        }
+        size_t tile_count = (size_t) ((rows + TILE_MASK) >> TILE_BITS) * tile_columns;
+        tiles.assign(tile_count, default_tile);
+        owned_tiles.resize(tile_count);
+    }
+
+    /// Whether every tile of a grid of the size of the table would contain a non-zero element of the table, so that a
+    /// grid written at those elements is better stored densely
+    static bool isEveryTileOccupied(const std::vector<std::vector<uint8_t>> &table) {
+        int table_rows = (int) table.size();
+        for (int tile_x = 0; tile_x < table_rows; tile_x += TILE_SIZE) {
+            int table_columns = (int) table[tile_x].size();
+            for (int tile_y = 0; tile_y < table_columns; tile_y += TILE_SIZE) {
+                bool is_occupied = false;
+                for (int x = tile_x; x < std::min(tile_x + TILE_SIZE, table_rows) && !is_occupied; x++) {
+                    auto row_begin = table[x].begin() + tile_y;
+                    auto row_end = table[x].begin() + std::min(tile_y + TILE_SIZE, table_columns);
+                    is_occupied = std::any_of(row_begin, row_end, [](uint8_t element) { return element != 0; });
+                }
+                if (!is_occupied) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    TiledGrid(const TiledGrid &other) :
+            origin(other.origin),
+            rows(other.rows),
+            columns(other.columns),
+            tile_columns(other.tile_columns),
+            tiles(other.tiles.size(), default_tile),
+            owned_tiles(other.owned_tiles.size()),
+            dense_elements(other.dense_elements) {
+        for (size_t i = 0; i < other.owned_tiles.size(); i++) {
+            if (other.owned_tiles[i]) {
+                owned_tiles[i].reset(new T[TILE_AREA]);
+                std::copy(other.owned_tiles[i].get(), other.owned_tiles[i].get() + TILE_AREA, owned_tiles[i].get());
+                tiles[i] = owned_tiles[i].get();
+            }
+        }
+    }
+
+    TiledGrid(TiledGrid &&other) noexcept = default;
+
+    TiledGrid &operator=(const TiledGrid &other) {
+        if (this != &other) {
+            *this = TiledGrid(other);
+        }
+        return *this;
+    }
+
+    TiledGrid &operator=(TiledGrid &&other) noexcept = default;
+
+    /// Value at the position, or the default value if the position is outside of the grid
+    [[nodiscard]] T get(int x, int y) const {
+        x -= origin.x;
+        y -= origin.y;
+        if ((unsigned) x >= (unsigned) rows || (unsigned) y >= (unsigned) columns) {
+            return T();
+        }
+        if (!dense_elements.empty()) {
+            return dense_elements[denseIndex(x, y)];
+        }
+        return tiles[tileIndex(x, y)][elementIndex(x, y)];
+    }
+
+    [[nodiscard]] T get(const coord &position) const {
+        return get(position.x, position.y);
+    }
+
+    /// Reference to the element at the position, which has to be within the grid, allocating its tile if it was not
+    /// written before
+    T &getReference(int x, int y) {
+        x -= origin.x;
+        y -= origin.y;
+        if (!dense_elements.empty()) {
+            return dense_elements[denseIndex(x, y)];
+        }
+        return allocateTile(tileIndex(x, y))[elementIndex(x, y)];
+    }
+
+    T &getReference(const coord &position) {
+        return getReference(position.x, position.y);
+    }
+
+    [[nodiscard]] bool contains(const coord &position) const {
+        return (unsigned) (position.x - origin.x) < (unsigned) rows &&
+               (unsigned) (position.y - origin.y) < (unsigned) columns;
+    }
+
+    /// Adds the values of a grid whose window lies within this one, going only through the tiles it has allocated
+    void add(const TiledGrid &other) {
+        if (!other.dense_elements.empty()) {
+            for (int x = 0; x < other.rows; x++) {
+                for (int y = 0; y < other.columns; y++) {
+                    T value = other.dense_elements[other.denseIndex(x, y)];
+                    if (value != T()) {
+                        getReference(other.origin.x + x, other.origin.y + y) += value;
+                    }
+                }
+            }
+            return;
+        }
+        for (size_t i = 0; i < other.owned_tiles.size(); i++) {
+            if (!other.owned_tiles[i]) {
+                continue;
+            }
+            const T *other_tile = other.owned_tiles[i].get();
+            int tile_x = (int) (i / other.tile_columns) << TILE_BITS;
+            int tile_y = (int) (i % other.tile_columns) << TILE_BITS;
+            for (int x = tile_x; x < std::min(tile_x + TILE_SIZE, other.rows); x++) {
+                for (int y = tile_y; y < std::min(tile_y + TILE_SIZE, other.columns); y++) {
+                    T value = other_tile[elementIndex(x, y)];
+                    if (value != T()) {
+                        getReference(other.origin.x + x, other.origin.y + y) += value;
+                    }
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] int getRows() const {
+        return rows;
+    }
+
+    [[nodiscard]] int getColumns() const {
+        return columns;
+    }
+
+    [[nodiscard]] bool isDense() const {
+        return !dense_elements.empty();
+    }
+
+    [[nodiscard]] size_t getAllocatedTiles() const {
+        size_t allocated_tiles = 0;
+        for (const std::unique_ptr<T[]> &tile: owned_tiles) {
+            allocated_tiles += tile != nullptr;
+        }
+        return allocated_tiles;
+    }
+
+    /// Memory taken by the grid in bytes
+    [[nodiscard]] size_t getAllocatedBytes() const {
+        return dense_elements.capacity() * sizeof(T) + getAllocatedTiles() * TILE_AREA * sizeof(T) +
+               tiles.capacity() * (sizeof(T *) + sizeof(std::unique_ptr<T[]>));
+    }
+
+    /// Dense copy of the window of the grid, with the default value of T in the tiles that were not written
+    [[nodiscard]] std::vector<std::vector<T>> toTable() const {
+        std::vector<std::vector<T>> table(rows, std::vector<T>(columns));
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < columns; y++) {
+                table[x][y] = get(origin.x + x, origin.y + y);
+            }
+        }
+        return table;
+    }
+};
+
+#endif //VECTOR_SLICER_TILED_GRID_H
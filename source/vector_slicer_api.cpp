@@ -50,3 +50,8 @@ SLICER_DLLEXPORT void slice_pattern_variable_width(const char *pattern_directory
     fs::path pattern_path_fs(pattern_directory);
     variableWidthOptimisation(pattern_path_fs, seeds);
 }
+
+SLICER_DLLEXPORT void re_score_pattern(const char *pattern_directory) {
+    fs::path pattern_path_fs(pattern_directory);
+    rescorePattern(pattern_path_fs);
+}
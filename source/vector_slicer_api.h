@@ -43,6 +43,9 @@ SLICER_DLLEXPORT void re_slice_pattern(const char *pattern_directory);
 /// Slices pattern using variable width preset, i.e. no optimisation but seeds.
 SLICER_DLLEXPORT void slice_pattern_variable_width(const char *pattern_directory, int seeds);
 
+/// Ranks previously evaluated generating parameters of the pattern using the current disagreement function.
+SLICER_DLLEXPORT void re_score_pattern(const char *pattern_directory);
+
 
 
 #endif //VECTOR_SLICER_VECTOR_SLICER_API_H